@@ -0,0 +1,143 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Accept Throughput Benchmark
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * New connections per second as the number of event loops grows, with
+ * one shared listener (loop 0 accepts and deals connections out) and with
+ * one SO_REUSEPORT listener per loop. Each client thread connects, sends
+ * GET /health with Connection: close, reads the response and closes.
+ * Built with -DSEC_ANALYZER_BUILD_BENCHMARKS=ON (Linux).
+ *
+ * Scaling only shows with at least as many cores as event loops, plus
+ * headroom for the client threads; on fewer the figures are a regression
+ * check, not a scaling result.
+ *
+ * Usage: accept_bench [seconds] [client_threads] [port]
+ */
+
+#include <sec_analyzer/http_server.h>
+#include <sec_analyzer/logger.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace sec_analyzer;
+
+namespace {
+
+struct ClientResult {
+    long completed = 0;
+    long failed = 0;
+};
+
+ClientResult run_clients(int port, int threads, std::chrono::duration<double> duration) {
+    static const char REQUEST[] = "GET /health HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+    std::atomic<long> completed{0};
+    std::atomic<long> failed{0};
+    std::atomic<bool> stop{false};
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    std::vector<std::thread> clients;
+    for (int t = 0; t < threads; ++t) {
+        clients.emplace_back([&] {
+            char buffer[4096];
+            while (!stop) {
+                int fd = socket(AF_INET, SOCK_STREAM, 0);
+                // Reset on close so client ports do not pile up in TIME_WAIT
+                linger no_linger{1, 0};
+                setsockopt(fd, SOL_SOCKET, SO_LINGER, &no_linger, sizeof(no_linger));
+                if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+                    failed++;
+                    close(fd);
+                    continue;
+                }
+                send(fd, REQUEST, sizeof(REQUEST) - 1, MSG_NOSIGNAL);
+                bool answered = false;
+                while (recv(fd, buffer, sizeof(buffer), 0) > 0) {
+                    answered = true;
+                }
+                close(fd);
+                answered ? completed++ : failed++;
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(duration);
+    stop = true;
+    for (auto& client : clients) {
+        client.join();
+    }
+    return {completed.load(), failed.load()};
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 3.0;
+    int client_threads = argc > 2 ? std::atoi(argv[2]) : 8;
+    int port = argc > 3 ? std::atoi(argv[3]) : 18480;
+    if (seconds <= 0 || client_threads <= 0 || port <= 0) {
+        std::cerr << "Usage: accept_bench [seconds] [client_threads] [port]\n";
+        return 1;
+    }
+
+    Logger::instance().set_level(LogLevel::ERROR);
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << cores << " CPU(s), " << client_threads << " client thread(s), " << seconds << " s per run\n";
+    if (cores < 2) {
+        std::cout << "Single CPU: listener scaling cannot show here\n";
+    }
+
+    std::vector<int> loop_counts{1, 2, 4};
+    for (int count = 8; count <= static_cast<int>(cores); count *= 2) {
+        loop_counts.push_back(count);
+    }
+
+    std::cout << std::left << std::setw(12) << "io-threads" << std::setw(18) << "listeners"
+              << std::right << std::setw(10) << "conn/s" << std::setw(10) << "failed" << "\n";
+
+    for (bool reuse_port : {false, true}) {
+        for (int loops : loop_counts) {
+            if (reuse_port && loops == 1) continue;  // Same as one shared listener
+
+            HttpServer server;
+            server.set_port(port);
+            server.set_io_threads(loops);
+            server.set_reuse_port(reuse_port);
+            server.set_compression(0, 0);
+            server.get("/health", [](const HttpRequest&) {
+                return HttpResponse::ok("{\"status\":\"ok\"}");
+            });
+            if (!server.start()) {
+                std::cerr << "Could not start a server on port " << port << "\n";
+                return 1;
+            }
+
+            ClientResult result = run_clients(port, client_threads, std::chrono::duration<double>(seconds));
+            server.stop();
+
+            std::string listeners = reuse_port ? std::to_string(loops) + " SO_REUSEPORT" : "1 shared";
+            std::cout << std::left << std::setw(12) << loops << std::setw(18) << listeners
+                      << std::right << std::setw(10) << static_cast<long>(result.completed / seconds)
+                      << std::setw(10) << result.failed << "\n";
+        }
+    }
+
+    return 0;
+}
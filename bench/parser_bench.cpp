@@ -0,0 +1,121 @@
+/**
+ * SEC EDGAR Fraud Analyzer - HTTP Request Parser Benchmark
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Requests per second for HttpRequestParser on a typical dashboard
+ * request, against the istringstream parser it replaced (kept here as
+ * the baseline). Built with -DSEC_ANALYZER_BUILD_BENCHMARKS=ON.
+ *
+ * Usage: parser_bench [iterations]
+ */
+
+#include <sec_analyzer/http_parser.h>
+#include <sec_analyzer/http_server.h>
+#include <sec_analyzer/util.h>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace sec_analyzer;
+
+namespace {
+
+const std::string SAMPLE_REQUEST =
+    "GET /api/analyze?ticker=AAPL&years=5 HTTP/1.1\r\n"
+    "Host: localhost:8080\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 Chrome/120.0\r\n"
+    "Accept: application/json, text/plain, */*\r\n"
+    "Accept-Language: en-US,en;q=0.9\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Connection: keep-alive\r\n"
+    "Referer: http://localhost:8080/\r\n"
+    "\r\n";
+
+// The parser HttpServer used before HttpRequestParser (v2.1.2 baseline)
+HttpRequest istringstream_parse(const std::string& raw) {
+    HttpRequest request;
+    std::istringstream stream(raw);
+    std::string line;
+
+    if (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        std::istringstream request_line(line);
+        std::string version;
+        request_line >> request.method >> request.path >> version;
+
+        size_t query_pos = request.path.find('?');
+        if (query_pos != std::string::npos) {
+            request.query_string = request.path.substr(query_pos + 1);
+            request.path = request.path.substr(0, query_pos);
+            std::istringstream params_stream(request.query_string);
+            std::string param;
+            while (std::getline(params_stream, param, '&')) {
+                size_t eq_pos = param.find('=');
+                if (eq_pos != std::string::npos) {
+                    request.params[util::url_decode(param.substr(0, eq_pos))] =
+                        util::url_decode(param.substr(eq_pos + 1));
+                }
+            }
+        }
+    }
+
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) break;
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+            request.headers[util::trim(line.substr(0, colon))] = util::trim(line.substr(colon + 1));
+        }
+    }
+    return request;
+}
+
+template<typename Fn>
+void measure(const char* label, int iterations, Fn&& parse_once) {
+    size_t sink = 0;
+    auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink += parse_once();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::cout << std::left << std::setw(32) << label
+              << std::right << std::setw(12) << static_cast<long>(iterations / seconds) << " req/s"
+              << (sink == 0 ? " (no output?)" : "") << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 500000;
+    if (iterations <= 0) {
+        std::cerr << "Usage: parser_bench [iterations]\n";
+        return 1;
+    }
+
+    std::cout << iterations << " iterations of a " << SAMPLE_REQUEST.size() << "-byte request\n";
+
+    measure("istringstream parser", iterations, [] {
+        return istringstream_parse(SAMPLE_REQUEST).headers.size();
+    });
+
+    // What the event loop does per request: frame it and find the route
+    HttpRequestParser parser;
+    measure("HttpRequestParser (frame+route)", iterations, [&parser] {
+        parser.reset();
+        parser.parse(SAMPLE_REQUEST);
+        return HttpRequestView(SAMPLE_REQUEST, parser.layout()).path().size();
+    });
+
+    // Plus the owned HttpRequest a handler receives
+    measure("HttpRequestParser + materialize", iterations, [&parser] {
+        parser.reset();
+        parser.parse(SAMPLE_REQUEST);
+        return HttpRequestView(SAMPLE_REQUEST, parser.layout()).materialize("127.0.0.1").headers.size();
+    });
+
+    return 0;
+}
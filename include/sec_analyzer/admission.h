@@ -0,0 +1,92 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Admission Control
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Load shedding for the request path. Two signals decide whether a request
+ * is worth starting:
+ *  - In-flight requests: handlers running or waiting on a deferred answer.
+ *    Normal requests may fill the whole budget; bulk work (cold analyses)
+ *    only half of it, so cheap requests still get through under load.
+ *  - Queue delay, CoDel style: waiting for a worker is fine as long as the
+ *    wait drops below the target at least once per interval. Once it has
+ *    stayed above the target for a whole interval the queue is standing,
+ *    and requests that waited longer than the target are turned away
+ *    until it drains, rather than served late.
+ * Critical requests (health checks) are never shed. All state is atomics.
+ */
+
+#ifndef SEC_ANALYZER_ADMISSION_H
+#define SEC_ANALYZER_ADMISSION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+namespace sec_analyzer {
+
+enum class RequestPriority {
+    CRITICAL,   // Always admitted
+    NORMAL,     // Shed at the in-flight limit or when late in a standing queue
+    BULK        // Expensive work: shed first, at half the in-flight limit
+};
+
+struct AdmissionConfig {
+    size_t max_in_flight = 512;                 // 0 = no in-flight limit
+    std::chrono::milliseconds target_delay{5};  // Acceptable queue wait, 0 disables delay shedding
+    std::chrono::milliseconds interval{100};    // How long the wait may stay above target
+    int retry_after_seconds = 1;                // Sent with every shed response
+};
+
+struct AdmissionStats {
+    uint64_t admitted = 0;
+    uint64_t shed_in_flight = 0;    // Refused at the in-flight limit
+    uint64_t shed_queue = 0;        // Refused for waiting too long in a standing queue
+    size_t in_flight = 0;
+    double queue_delay_ms = 0.0;    // Most recent queue wait observed
+    bool standing_queue = false;
+};
+
+class AdmissionController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit AdmissionController(AdmissionConfig config = {});
+
+    AdmissionController(const AdmissionController&) = delete;
+    AdmissionController& operator=(const AdmissionController&) = delete;
+
+    /**
+     * Decide on a request that waited queue_delay for a worker. On true
+     * the request counts as in flight until release().
+     */
+    bool admit(RequestPriority priority, Clock::duration queue_delay);
+    void release();
+
+    // Whether new work of this priority should be turned away right now
+    bool overloaded(RequestPriority priority) const;
+
+    int retry_after_seconds() const { return config_.retry_after_seconds; }
+    AdmissionStats stats() const;
+
+private:
+    AdmissionConfig config_;
+    int64_t target_ns_;
+    int64_t interval_ns_;
+
+    std::atomic<size_t> in_flight_{0};
+    std::atomic<int64_t> above_target_since_ns_{0}; // First of the current run of late waits, 0 if none
+    std::atomic<int64_t> last_delay_ns_{0};
+    std::atomic<uint64_t> admitted_{0};
+    std::atomic<uint64_t> shed_in_flight_{0};
+    std::atomic<uint64_t> shed_queue_{0};
+
+    static int64_t now_ns();
+    bool standing_queue(int64_t now) const;
+    size_t limit_for(RequestPriority priority) const;
+};
+
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_ADMISSION_H
@@ -17,9 +17,20 @@
 #include "models/fraud_triangle.h"
 #include "models/benford.h"
 #include <memory>
+#include <functional>
 
 namespace sec_analyzer {
 
+// One step of a running analysis, reported through ProgressCallback
+struct AnalysisProgress {
+    std::string stage;      // "lookup", "filings", "extract", model names, "scoring"
+    std::string detail;
+    int current = 0;        // Steps done within the stage (0 if not counted)
+    int total = 0;
+};
+
+using ProgressCallback = std::function<void(const AnalysisProgress&)>;
+
 class FraudAnalyzer {
 public:
     FraudAnalyzer();
@@ -31,9 +42,12 @@ public:
     void set_fetcher(std::shared_ptr<SECFetcher> fetcher) { fetcher_ = fetcher; }
     
     // Main analysis functions
-    AnalysisResult analyze_by_ticker(const std::string& ticker, int years = 5);
-    AnalysisResult analyze_by_cik(const std::string& cik, int years = 5);
-    AnalysisResult analyze_financials(const std::vector<FinancialData>& financials, const CompanyInfo& company);
+    AnalysisResult analyze_by_ticker(const std::string& ticker, int years = 5,
+                                     const ProgressCallback& progress = nullptr);
+    AnalysisResult analyze_by_cik(const std::string& cik, int years = 5,
+                                  const ProgressCallback& progress = nullptr);
+    AnalysisResult analyze_financials(const std::vector<FinancialData>& financials, const CompanyInfo& company,
+                                      const ProgressCallback& progress = nullptr);
     
     // Individual model analysis
     BeneishResult calculate_beneish(const FinancialData& current, const FinancialData& prior);
@@ -52,15 +66,10 @@ public:
     double calculate_composite_score(const AnalysisResult& result);
     RiskLevel determine_risk_level(double score);
     std::string generate_recommendation(const AnalysisResult& result);
-    
-    // Error handling
-    std::string get_last_error() const { return last_error_; }
-    bool has_error() const { return !last_error_.empty(); }
 
 private:
     RiskWeights weights_;
     std::shared_ptr<SECFetcher> fetcher_;
-    std::string last_error_;
     
     // Model instances
     std::unique_ptr<BeneishModel> beneish_model_;
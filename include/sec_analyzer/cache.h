@@ -11,37 +11,51 @@
 
 #include <string>
 #include <unordered_map>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <chrono>
 #include <optional>
 #include <fstream>
+#include <algorithm>
+#include <cstdint>
 
 namespace sec_analyzer {
 
 template<typename T>
 class Cache {
 public:
+    // A live entry, its validator (e.g. a quoted ETag) and seconds left before it expires
+    struct Hit {
+        T value;
+        std::string tag;
+        int ttl_remaining = 0;
+    };
+    
     explicit Cache(int ttl_seconds = 3600) : ttl_seconds_(ttl_seconds) {}
     
-    void set(const std::string& key, const T& value) {
+    void set(const std::string& key, const T& value, const std::string& tag = "") {
         std::lock_guard<std::mutex> lock(mutex_);
-        entries_[key] = CacheEntry{value, std::chrono::steady_clock::now()};
+        entries_[key] = CacheEntry{value, tag, std::chrono::steady_clock::now()};
     }
     
     std::optional<T> get(const std::string& key) {
         std::lock_guard<std::mutex> lock(mutex_);
-        auto it = entries_.find(key);
+        auto it = find_live(key);
         if (it == entries_.end()) return std::nullopt;
-        
-        auto age = std::chrono::steady_clock::now() - it->second.timestamp;
-        if (std::chrono::duration_cast<std::chrono::seconds>(age).count() > ttl_seconds_) {
-            entries_.erase(it);
-            return std::nullopt;
-        }
-        
         return it->second.value;
     }
     
+    std::optional<Hit> lookup(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = find_live(key);
+        if (it == entries_.end()) return std::nullopt;
+        
+        auto age = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - it->second.timestamp).count();
+        return Hit{it->second.value, it->second.tag, static_cast<int>(std::max<long long>(0, ttl_seconds_ - age))};
+    }
+    
     bool contains(const std::string& key) {
         return get(key).has_value();
     }
@@ -80,12 +94,93 @@ public:
 private:
     struct CacheEntry {
         T value;
+        std::string tag;
         std::chrono::steady_clock::time_point timestamp;
     };
     
     mutable std::mutex mutex_;
     std::unordered_map<std::string, CacheEntry> entries_;
     int ttl_seconds_;
+    
+    // Caller holds mutex_; expired entries are dropped on the way
+    typename std::unordered_map<std::string, CacheEntry>::iterator find_live(const std::string& key) {
+        auto it = entries_.find(key);
+        if (it == entries_.end()) return it;
+        
+        auto age = std::chrono::steady_clock::now() - it->second.timestamp;
+        if (std::chrono::duration_cast<std::chrono::seconds>(age).count() > ttl_seconds_) {
+            entries_.erase(it);
+            return entries_.end();
+        }
+        return it;
+    }
+};
+
+/**
+ * Cache of outbound HTTP response bodies. Each entry has its own freshness
+ * lifetime and keeps its validators (ETag, Last-Modified) after that runs
+ * out, so a stale entry can be revalidated with a conditional GET instead
+ * of downloaded again. Least recently used entries are evicted once the
+ * bodies held exceed the byte budget.
+ */
+struct CachedResponse {
+    std::shared_ptr<const std::string> body;
+    std::string etag;
+    std::string last_modified;
+    bool fresh = false;
+};
+
+struct ResponseCacheStats {
+    uint64_t hits = 0;              // Served without a request
+    uint64_t revalidated = 0;       // Confirmed unchanged by a 304
+    uint64_t misses = 0;            // Absent, or changed since stored
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+class ResponseCache {
+public:
+    static constexpr size_t DEFAULT_MAX_BYTES = 256 * 1024 * 1024;
+    
+    explicit ResponseCache(size_t max_bytes = DEFAULT_MAX_BYTES) : max_bytes_(max_bytes) {}
+    
+    // Fresh or stale entry for key; counts nothing
+    std::optional<CachedResponse> get(const std::string& key);
+    
+    // Store a body fresh for ttl; bodies over a quarter of the budget are not kept
+    void put(const std::string& key, std::string body, std::string etag,
+             std::string last_modified, std::chrono::seconds ttl);
+    void put(const std::string& key, std::shared_ptr<const std::string> body, std::string etag,
+             std::string last_modified, std::chrono::seconds ttl);
+    
+    // A 304 confirmed the stored body; it is fresh for ttl again
+    void refresh(const std::string& key, std::chrono::seconds ttl);
+    
+    // Outcome of a fetch that consulted the cache, for stats()
+    void record_hit() { std::lock_guard<std::mutex> lock(mutex_); ++stats_.hits; }
+    void record_revalidated() { std::lock_guard<std::mutex> lock(mutex_); ++stats_.revalidated; }
+    void record_miss() { std::lock_guard<std::mutex> lock(mutex_); ++stats_.misses; }
+    
+    void clear();
+    ResponseCacheStats stats() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<const std::string> body;
+        std::string etag;
+        std::string last_modified;
+        std::chrono::steady_clock::time_point expires;
+        std::list<std::string>::iterator recency;
+    };
+    
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> recency_;    // Most recently used first
+    size_t max_bytes_;
+    ResponseCacheStats stats_;
+    
+    void erase(std::unordered_map<std::string, Entry>::iterator it);
 };
 
 /**
@@ -0,0 +1,104 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Company Directory
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Resident copy of SEC's ticker list (company_tickers.json), loaded once
+ * and refreshed in the background. Tickers and CIKs resolve through hash
+ * maps; name search goes through a trigram index (queries of three or more
+ * characters, matched as substrings of name or ticker) and a sorted list of
+ * word prefixes (shorter queries). Each refresh builds a complete new
+ * snapshot and swaps it in, so lookups never wait on a download.
+ */
+
+#ifndef SEC_ANALYZER_COMPANY_DIRECTORY_H
+#define SEC_ANALYZER_COMPANY_DIRECTORY_H
+
+#include "types.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <optional>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+
+namespace sec_analyzer {
+
+class JsonValue;
+
+struct CompanyDirectoryStats {
+    size_t companies = 0;
+    uint64_t refreshes = 0;         // Successful loads
+    uint64_t failures = 0;
+    int64_t age_seconds = -1;       // Since the current snapshot was loaded; -1 before the first
+};
+
+class CompanyDirectory {
+public:
+    static constexpr size_t MAX_SEARCH_RESULTS = 10;
+    static constexpr std::chrono::seconds RETRY_INTERVAL{60};
+
+    // Fetches and parses company_tickers.json; nullopt and error if that failed
+    using Loader = std::function<std::optional<JsonValue>(std::string& error)>;
+
+    explicit CompanyDirectory(Loader loader);
+    ~CompanyDirectory();
+
+    CompanyDirectory(const CompanyDirectory&) = delete;
+    CompanyDirectory& operator=(const CompanyDirectory&) = delete;
+
+    /**
+     * Load in the background now and again every interval (sooner after
+     * a failure, every RETRY_INTERVAL). Without this the directory is
+     * loaded on first use and never refreshed.
+     */
+    void start(std::chrono::seconds interval);
+    void stop();
+
+    // Load now unless a snapshot is already present; false (and *error) if that failed
+    bool ensure_loaded(std::string* error = nullptr);
+
+    // Replace the snapshot with one built from a company_tickers.json document
+    bool load(const JsonValue& document);
+
+    // Ticker as written by SEC or with '.' for '-' (BRK.B), any case
+    std::optional<CompanyInfo> find_ticker(std::string_view ticker) const;
+    std::optional<CompanyInfo> find_cik(const std::string& cik) const;
+
+    // Exact ticker match first, then the rest in SEC's listing order
+    std::vector<CompanyInfo> search(std::string_view query, size_t limit = MAX_SEARCH_RESULTS) const;
+
+    bool loaded() const;
+    CompanyDirectoryStats stats() const;
+
+private:
+    struct Snapshot;
+
+    Loader loader_;
+    std::shared_ptr<const Snapshot> snapshot_;
+    mutable std::mutex mutex_;          // Guards snapshot_ pointer swaps
+    std::mutex load_mutex_;             // One download at a time
+
+    std::atomic<uint64_t> refreshes_{0};
+    std::atomic<uint64_t> failures_{0};
+
+    std::atomic<bool> running_{false};
+    std::thread refresher_;
+    std::mutex refresher_mutex_;
+    std::condition_variable refresher_cv_;
+
+    std::shared_ptr<const Snapshot> current() const;
+    bool refresh(std::string* error = nullptr);
+    void refresh_loop(std::chrono::seconds interval);
+};
+
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_COMPANY_DIRECTORY_H
@@ -0,0 +1,50 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Compression Helpers
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Thin wrapper over zlib for response compression. zlib is optional:
+ * when the build does not find it (SEC_ANALYZER_HAS_ZLIB undefined)
+ * available() is false and every encoder reports failure, so callers
+ * simply send the identity encoding.
+ */
+
+#ifndef SEC_ANALYZER_COMPRESSION_H
+#define SEC_ANALYZER_COMPRESSION_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace sec_analyzer {
+namespace compression {
+
+bool available();
+
+// gzip container (RFC 1952); level 1-9. Returns false on failure.
+bool gzip(std::string_view input, std::string& output, int level = 6);
+
+// HTTP "deflate" coding, i.e. the zlib container (RFC 1950)
+bool deflate(std::string_view input, std::string& output, int level = 6);
+
+// Compress with a negotiated coding name ("gzip" or "deflate")
+bool encode(std::string_view coding, std::string_view input, std::string& output, int level = 6);
+
+// Decompress a body received with Content-Encoding `coding` ("gzip" or "deflate");
+// max_output bounds the result. Returns false on failure or overflow.
+bool decode(std::string_view coding, std::string_view input, std::string& output,
+            size_t max_output = SIZE_MAX);
+
+// True for MIME types that are worth compressing (text, JSON, JS, SVG, ...)
+bool is_compressible(std::string_view content_type);
+
+// Whether an Accept-Encoding header value allows `coding` (honours q=0 and "*")
+bool accepts(std::string_view accept_encoding, std::string_view coding);
+
+// Preferred coding we can produce for an Accept-Encoding value; empty for identity
+std::string_view negotiate(std::string_view accept_encoding);
+
+} // namespace compression
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_COMPRESSION_H
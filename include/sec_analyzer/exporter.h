@@ -27,6 +27,11 @@ public:
     // Export to HTML report
     static std::string to_html(const AnalysisResult& result);
     
+    // HTML report pieces, so several reports can be streamed as one document
+    static std::string html_document_start(const std::string& title);
+    static std::string html_report_section(const AnalysisResult& result);
+    static std::string html_document_end(const std::string& version);
+    
     // Export specific sections
     static std::string models_to_json(const AnalysisResult& result);
     static std::string red_flags_to_json(const std::vector<RedFlag>& flags);
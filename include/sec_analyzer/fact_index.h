@@ -0,0 +1,88 @@
+/**
+ * SEC EDGAR Fraud Analyzer - XBRL Fact Index
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Hash index over the us-gaap facts of a company facts document, built in
+ * one pass. Each reported value is keyed by (concept, unit, fiscal year,
+ * fiscal period, form) packed into one integer, so reading a filing's
+ * figures costs a few hash probes per field instead of a scan of every
+ * value the concept was ever reported with.
+ *
+ * Only the first value reported under a key is kept, together with its
+ * position in the document, which is what lets value() reproduce "first
+ * match in document order" across the several keys a query spans.
+ */
+
+#ifndef SEC_ANALYZER_FACT_INDEX_H
+#define SEC_ANALYZER_FACT_INDEX_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <optional>
+#include <span>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+namespace sec_analyzer {
+
+class JsonValue;
+
+// Units that are indexed, in the order value() tries them
+enum class FactUnit : uint8_t { USD, PURE, SHARES };
+
+// "fp" of a reported value; anything else (Q4, H1, missing, ...) is OTHER
+enum class FiscalPeriod : uint8_t { FY, Q1, Q2, Q3, OTHER };
+
+// "form" of the filing that reported a value; amendments count as OTHER
+enum class FactForm : uint8_t { K10, Q10, OTHER };
+
+class FactIndex {
+public:
+    FactIndex() = default;
+
+    /**
+     * Index facts["us-gaap"] of a company facts document, all of it or just
+     * the listed concepts (a filer reports hundreds; a reader needs a few).
+     * Entries without a numeric fy or val are skipped.
+     */
+    explicit FactIndex(const JsonValue& facts, std::span<const std::string_view> concepts = {});
+
+    /**
+     * The first value reported for concept in fiscal_year by an annual
+     * entry (form 10-K or fp FY) or a quarterly one (form 10-Q or fp
+     * Q1-Q3), trying USD, then pure, then shares. 0 if there is none.
+     */
+    double value(std::string_view concept_name, int fiscal_year, bool annual) const;
+
+    // Exact lookup of the first value reported under this key
+    std::optional<double> find(std::string_view concept_name, FactUnit unit, int fiscal_year,
+                               FiscalPeriod period, FactForm form) const;
+
+    size_t size() const { return facts_.size(); }
+    size_t concept_count() const { return concepts_.size(); }
+
+private:
+    struct Fact {
+        double value;
+        uint32_t position;          // Index in the concept's unit array
+    };
+
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+    };
+
+    std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> concepts_;
+    std::unordered_map<uint64_t, Fact> facts_;
+
+    void add_concept(const std::string& name, const JsonValue& concept_data);
+    static uint64_t key(uint32_t concept_id, FactUnit unit, int fiscal_year, FiscalPeriod period, FactForm form);
+    const Fact* probe(uint32_t concept_id, FactUnit unit, int fiscal_year, FiscalPeriod period, FactForm form) const;
+};
+
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_FACT_INDEX_H
@@ -0,0 +1,134 @@
+/**
+ * SEC EDGAR Fraud Analyzer - HTTP Client
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Minimal in-process HTTP/1.1 client for outbound GETs. Connections are
+ * kept alive and pooled per origin (scheme, host, port), so repeated
+ * requests to SEC EDGAR skip DNS, TCP and TLS setup; a pooled connection
+ * the server has closed is detected before reuse, and a request that
+ * fails on a reused connection before any response arrives is retried
+ * once on a fresh one. Responses are framed by Content-Length, chunked
+ * encoding or connection close, and gzip bodies are decoded when built
+ * with zlib.
+ *
+ * HTTPS needs OpenSSL (SEC_ANALYZER_HAS_OPENSSL). Builds without it fetch
+ * https URLs through the curl command line tool instead, one process per
+ * request. POSIX only; Windows builds use WinHTTP in sec_fetcher.cpp.
+ */
+
+#ifndef SEC_ANALYZER_HTTP_CLIENT_H
+#define SEC_ANALYZER_HTTP_CLIENT_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace sec_analyzer {
+
+struct HttpClientResponse {
+    int status = 0;                                 // 0 when no response was received
+    std::map<std::string, std::string> headers;     // Names lower-cased, repeats joined with ", "
+    std::string body;                               // Empty when a BodySink consumed it
+    std::string error;                              // Transport failure; empty if a response arrived
+
+    bool ok() const { return error.empty() && status >= 200 && status < 300; }
+    std::string header(const std::string& name) const {
+        auto it = headers.find(name);
+        return it != headers.end() ? it->second : std::string();
+    }
+};
+
+struct HttpClientStats {
+    uint64_t requests = 0;
+    uint64_t connections_opened = 0;
+    uint64_t connections_reused = 0;
+    uint64_t retries = 0;           // Reused connections found dead mid-request
+    size_t idle_connections = 0;
+};
+
+// Receives the body of a successful response piece by piece; return false to abort
+using BodySink = std::function<bool(std::string_view chunk)>;
+
+using HttpHeaderList = std::vector<std::pair<std::string, std::string>>;
+
+class HttpClient {
+public:
+    static constexpr size_t DEFAULT_MAX_RESPONSE_SIZE = 256 * 1024 * 1024;
+    static constexpr int MAX_REDIRECTS = 5;
+
+    HttpClient();
+    ~HttpClient();
+
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    // Configuration; set before the first request
+    void set_timeout(int seconds) { timeout_seconds_ = seconds; }
+    void set_max_idle_per_host(size_t count) { max_idle_per_host_ = count; }
+    void set_idle_timeout(int seconds) { idle_timeout_seconds_ = seconds; }
+    void set_max_response_size(size_t bytes) { max_response_size_ = bytes; }
+
+    /**
+     * Send every request to this origin ("http://127.0.0.1:8089") instead
+     * of the URL's own, keeping path and query. For pointing the fetcher
+     * at a local stand-in server; empty restores normal behaviour.
+     */
+    void set_base_url(const std::string& base_url);
+
+    /**
+     * GET url, following up to MAX_REDIRECTS redirects. With a sink, the
+     * body of a 2xx response is streamed to it (uncompressed transfer)
+     * instead of collected in body. Safe to call from any thread.
+     */
+    HttpClientResponse get(const std::string& url, const HttpHeaderList& headers = {},
+                           const BodySink& sink = nullptr);
+
+    HttpClientStats stats() const;
+
+    // Whether https is served in process (built with OpenSSL)
+    static bool tls_available();
+
+private:
+    struct Connection;
+    struct Url;
+
+    int timeout_seconds_ = 30;
+    size_t max_idle_per_host_ = 8;
+    int idle_timeout_seconds_ = 30;
+    size_t max_response_size_ = DEFAULT_MAX_RESPONSE_SIZE;
+    std::string base_url_;
+
+    mutable std::mutex pool_mutex_;
+    std::unordered_map<std::string, std::vector<std::unique_ptr<Connection>>> idle_;
+
+    void* tls_context_ = nullptr;   // SSL_CTX when built with OpenSSL
+
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> opened_{0};
+    std::atomic<uint64_t> reused_{0};
+    std::atomic<uint64_t> retries_{0};
+
+    std::unique_ptr<Connection> acquire(const Url& url, bool& reused, std::string& error);
+    void release(const Url& url, std::unique_ptr<Connection> connection);
+    std::unique_ptr<Connection> connect(const Url& url, std::string& error);
+
+    HttpClientResponse send(const Url& url, const HttpHeaderList& headers, const BodySink& sink);
+    bool exchange(Connection& connection, const Url& url, const std::string& request,
+                  const BodySink& sink, HttpClientResponse& response, bool& reusable, bool& received);
+
+    HttpClientResponse curl_get(const Url& url, const HttpHeaderList& headers, const BodySink& sink);
+};
+
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_HTTP_CLIENT_H
@@ -0,0 +1,149 @@
+/**
+ * SEC EDGAR Fraud Analyzer - HTTP Request Parser
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Resumable, zero-copy HTTP/1.x request parser. The parser scans a
+ * per-connection byte buffer and records offsets into it; views over the
+ * buffer are only turned into owned strings when a handler needs them.
+ *
+ * Bodies are framed by Content-Length or decoded from chunked transfer
+ * encoding as bytes arrive. Oversize bodies are rejected with 413 as soon
+ * as the declared (or accumulated) size exceeds the limit.
+ */
+
+#ifndef SEC_ANALYZER_HTTP_PARSER_H
+#define SEC_ANALYZER_HTTP_PARSER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace sec_analyzer {
+
+struct HttpRequest;
+
+// Byte range relative to the first byte of the request
+struct Span {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+
+    std::string_view in(std::string_view base) const {
+        return base.substr(offset, length);
+    }
+};
+
+// Offsets of every request element; valid for any buffer holding the same bytes
+struct HttpRequestLayout {
+    Span method;
+    Span target;            // Path plus query string as sent
+    Span path;
+    Span query;
+    Span version;
+    Span body;
+    std::vector<std::pair<Span, Span>> headers;
+    size_t length = 0;      // Total bytes of this request, including body
+    bool chunked = false;
+    std::string decoded_body;   // Body bytes when chunked (body span is unused)
+};
+
+/**
+ * Read-only view of a parsed request. All accessors return views into the
+ * underlying buffer, which must outlive the view.
+ */
+class HttpRequestView {
+public:
+    HttpRequestView(std::string_view base, const HttpRequestLayout& layout)
+        : base_(base), layout_(&layout) {}
+
+    std::string_view method() const { return layout_->method.in(base_); }
+    std::string_view target() const { return layout_->target.in(base_); }
+    std::string_view path() const { return layout_->path.in(base_); }
+    std::string_view query() const { return layout_->query.in(base_); }
+    std::string_view version() const { return layout_->version.in(base_); }
+    std::string_view body() const {
+        return layout_->chunked ? std::string_view(layout_->decoded_body) : layout_->body.in(base_);
+    }
+
+    // Case-insensitive header lookup; empty view if absent
+    std::string_view header(std::string_view name) const;
+
+    // Owned copy for handlers (decodes query parameters)
+    HttpRequest materialize(const std::string& client_ip) const;
+
+private:
+    std::string_view base_;
+    const HttpRequestLayout* layout_;
+};
+
+class HttpRequestParser {
+public:
+    enum class Status {
+        INCOMPLETE,     // Need more bytes
+        COMPLETE,       // layout() describes one full request
+        ERROR           // Malformed; error_status() holds the HTTP status to send
+    };
+
+    static constexpr size_t MAX_HEADER_BYTES = 64 * 1024;
+    static constexpr size_t MAX_HEADER_COUNT = 100;
+    static constexpr size_t DEFAULT_MAX_BODY_SIZE = 10 * 1024 * 1024;
+
+    /**
+     * Parse the request starting at buffer[0]. Call again with the same
+     * (possibly grown) buffer after more bytes arrive; scanning resumes
+     * where it stopped.
+     */
+    Status parse(std::string_view buffer);
+
+    const HttpRequestLayout& layout() const { return layout_; }
+    HttpRequestLayout take_layout() { return std::move(layout_); }
+    int error_status() const { return error_status_; }
+    const std::string& error_message() const { return error_message_; }
+
+    // Prepare for the next request on the same connection
+    void reset();
+
+    void set_max_body_size(size_t bytes) { max_body_size_ = bytes; }
+
+    // Headers are complete and the body is still being received
+    bool awaiting_body() const { return state_ >= State::BODY && state_ < State::DONE; }
+
+    // Client sent "Expect: 100-continue"
+    bool expects_continue() const { return expect_continue_; }
+
+private:
+    enum class State {
+        REQUEST_LINE,
+        HEADERS,
+        BODY,
+        CHUNK_SIZE,
+        CHUNK_DATA,
+        CHUNK_TRAILERS,
+        DONE,
+        FAILED
+    };
+
+    State state_ = State::REQUEST_LINE;
+    size_t pos_ = 0;                // Next unscanned byte
+    size_t body_start_ = 0;
+    size_t content_length_ = 0;
+    size_t chunk_remaining_ = 0;
+    size_t max_body_size_ = DEFAULT_MAX_BODY_SIZE;
+    bool expect_continue_ = false;
+    HttpRequestLayout layout_;
+    int error_status_ = 0;
+    std::string error_message_;
+
+    bool parse_request_line(std::string_view line, size_t line_start);
+    bool parse_header_line(std::string_view line, size_t line_start);
+    bool finish_headers(std::string_view buffer);
+    Status parse_chunked(std::string_view buffer);
+    Status fail(int status, const std::string& message);
+};
+
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_HTTP_PARSER_H
@@ -4,6 +4,12 @@
  * Author: Bennie Shearer (Retired)
  * 
  * Cross-platform HTTP server implementation.
+ *
+ * On Linux connections are multiplexed over a small set of epoll I/O
+ * threads (edge-triggered, non-blocking sockets) and handlers run on a
+ * separate worker pool. The blocking thread-per-connection path is kept
+ * as a fallback for debugging and for platforms without epoll. Both modes
+ * run request work on a bounded pool sized from ServerConfig::thread_count.
  */
 
 #ifndef SEC_ANALYZER_HTTP_SERVER_H
@@ -16,6 +22,21 @@
 #include <atomic>
 #include <mutex>
 #include <vector>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <tuple>
+#include <chrono>
+#include <algorithm>
+#include <cctype>
+
+#include "thread_pool.h"
+#include "http_parser.h"
+#include "static_assets.h"
+#include "cache.h"
+#include "rate_limiter.h"
+#include "admission.h"
+#include "router.h"
 
 #ifdef _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
@@ -41,9 +62,16 @@ typedef int socket_t;
 
 namespace sec_analyzer {
 
+// Connection handling strategy
+enum class IoMode {
+    EVENT_LOOP,     // epoll I/O threads + worker pool (Linux)
+    BLOCKING        // One blocking recv/send thread per connection
+};
+
 struct HttpRequest {
     std::string method;
     std::string path;
+    std::string version;
     std::string query_string;
     std::map<std::string, std::string> headers;
     std::map<std::string, std::string> params;
@@ -58,14 +86,86 @@ struct HttpRequest {
     bool has_param(const std::string& name) const {
         return params.find(name) != params.end();
     }
+    
+    // Header names are case-insensitive (RFC 7230)
+    std::string get_header(const std::string& name, const std::string& default_val = "") const {
+        for (const auto& [key, value] : headers) {
+            if (key.size() == name.size() &&
+                std::equal(key.begin(), key.end(), name.begin(), [](char a, char b) {
+                    return std::tolower(static_cast<unsigned char>(a)) ==
+                           std::tolower(static_cast<unsigned char>(b));
+                })) {
+                return value;
+            }
+        }
+        return default_val;
+    }
+};
+
+/**
+ * Pull-style body source for streamed responses. Each call appends the
+ * next piece of the body to `out` and returns false once nothing more
+ * follows. Calls are made one at a time on a worker thread.
+ */
+using BodyProducer = std::function<bool(std::string& out)>;
+
+/**
+ * Asynchronous form of BodyProducer, for bodies whose pieces are computed
+ * elsewhere (such as on the analysis executor). Each call must eventually
+ * call next(piece, more) exactly once, from any thread; the following call
+ * is made only after that piece has gone out, so a slow reader still
+ * throttles the producer. Nothing waits in between.
+ */
+using ChunkCallback = std::function<void(std::string piece, bool more)>;
+using AsyncBodyProducer = std::function<void(ChunkCallback next)>;
+
+/**
+ * Push-style writer for long-lived streams such as Server-Sent Events.
+ * Each write() goes out as one chunk as soon as the I/O thread gets to
+ * it. Returns false once the client has gone away.
+ */
+class ResponseSink {
+public:
+    virtual ~ResponseSink() = default;
+    virtual bool write(std::string_view data) = 0;
 };
 
+// Runs on a worker once the headers are queued; the stream ends when it returns
+using StreamWriter = std::function<void(ResponseSink& sink)>;
+
+// One Server-Sent Events message; multi-line data becomes several data: lines
+inline std::string sse_event(std::string_view event, std::string_view data) {
+    std::string message = "event: ";
+    message.append(event).append("\n");
+    while (true) {
+        size_t newline = data.find('\n');
+        message.append("data: ").append(data.substr(0, newline)).append("\n");
+        if (newline == std::string_view::npos) break;
+        data.remove_prefix(newline + 1);
+    }
+    message.append("\n");
+    return message;
+}
+
 struct HttpResponse {
     int status_code = 200;
     std::string status_text = "OK";
     std::map<std::string, std::string> headers;
     std::string body;
     
+    // Alternative body sources the server writes without copying
+    std::shared_ptr<const std::string> shared_body;     // Immutable cached bytes
+    std::string file_path;                              // Streamed with sendfile
+    size_t file_size = 0;
+    BodyProducer producer;                              // Sent with chunked encoding
+    AsyncBodyProducer async_producer;                   // Sent with chunked encoding
+    StreamWriter stream_writer;                         // Pushed with chunked encoding
+    
+    // Compressed variants of this body are cached under this key (see set_compression_cache).
+    // A strong ETag header, if set, also answers If-None-Match with 304 and
+    // is suffixed with the content coding when the body gets compressed.
+    std::string variant_cache_key;
+    
     HttpResponse() = default;
     HttpResponse(int code, const std::string& text) : status_code(code), status_text(text) {}
     
@@ -83,6 +183,34 @@ struct HttpResponse {
         return res;
     }
     
+    size_t content_length() const {
+        if (shared_body) return shared_body->size();
+        if (!file_path.empty()) return file_size;
+        return body.size();
+    }
+    
+    static HttpResponse stream(BodyProducer producer, const std::string& content_type) {
+        HttpResponse res(200, "OK");
+        res.producer = std::move(producer);
+        res.headers["Content-Type"] = content_type;
+        return res;
+    }
+    
+    static HttpResponse async_stream(AsyncBodyProducer producer, const std::string& content_type) {
+        HttpResponse res(200, "OK");
+        res.async_producer = std::move(producer);
+        res.headers["Content-Type"] = content_type;
+        return res;
+    }
+    
+    static HttpResponse event_stream(StreamWriter writer) {
+        HttpResponse res(200, "OK");
+        res.stream_writer = std::move(writer);
+        res.headers["Content-Type"] = "text/event-stream";
+        res.headers["Cache-Control"] = "no-cache";
+        return res;
+    }
+    
     static HttpResponse not_found() {
         return error(404, "Not Found");
     }
@@ -98,6 +226,29 @@ struct HttpResponse {
 
 using RequestHandler = std::function<HttpResponse(const HttpRequest&)>;
 
+/**
+ * Completes a deferred request. Call exactly once, from any thread; later
+ * calls are ignored. The request's connection stays parked, holding no
+ * thread, until it is called.
+ */
+using ResponseCallback = std::function<void(HttpResponse response)>;
+
+/**
+ * Handler that may answer later, e.g. after handing slow I/O to its own
+ * executor. The request reference is only valid for the duration of the
+ * call; copy whatever the deferred work needs.
+ */
+using AsyncRequestHandler = std::function<void(const HttpRequest& request, ResponseCallback respond)>;
+
+struct CompressionStats {
+    uint64_t responses = 0;         // Responses sent with a Content-Encoding
+    uint64_t bytes_in = 0;          // Identity size of those responses
+    uint64_t bytes_out = 0;         // Encoded size actually sent
+    uint64_t variant_cache_hits = 0;
+    size_t variant_cache_entries = 0;
+    size_t variant_cache_bytes = 0;
+};
+
 class HttpServer {
 public:
     HttpServer();
@@ -108,6 +259,57 @@ public:
     void set_static_dir(const std::string& dir) { static_dir_ = dir; }
     void set_cors_enabled(bool enabled) { cors_enabled_ = enabled; }
     void set_max_body_size(size_t size) { max_body_size_ = size; }
+    void set_io_mode(IoMode mode) { io_mode_ = mode; }
+    void set_io_threads(int count) { io_threads_ = count > 0 ? count : 1; }
+    // One SO_REUSEPORT listener per event loop instead of one shared listener (Linux)
+    void set_reuse_port(bool enabled) { reuse_port_ = enabled; }
+    // Pin event loop i to CPU i (Linux)
+    void set_pin_io_threads(bool enabled) { pin_io_threads_ = enabled; }
+    void set_thread_count(int count) { thread_count_ = count > 0 ? count : 1; }
+    void set_queue_capacity(size_t capacity) { queue_capacity_ = capacity; }
+    void set_keep_alive_timeout(int seconds) { keep_alive_timeout_seconds_ = seconds; }
+    void set_max_requests_per_connection(int count) { max_requests_per_connection_ = count; }
+    
+    // Client deadlines in seconds: whole request head, body inactivity, response write inactivity
+    void set_timeouts(int header_seconds, int body_seconds, int write_seconds) {
+        header_timeout_seconds_ = header_seconds;
+        body_timeout_seconds_ = body_seconds;
+        write_timeout_seconds_ = write_seconds;
+    }
+    
+    // gzip/deflate for handler responses; level 0 disables, bodies under min_size are sent as-is
+    void set_compression(int level, size_t min_size) {
+        compression_level_ = std::clamp(level, 0, 9);
+        compression_min_size_ = min_size;
+    }
+    // Keeps compressed variants of responses that set variant_cache_key, each for ttl
+    void set_compression_cache(std::shared_ptr<ResponseCache> cache, std::chrono::seconds ttl) {
+        compression_cache_ = std::move(cache);
+        compression_cache_ttl_ = ttl;
+    }
+    
+    // Routed requests over the client's budget get 429 before their handler runs.
+    // Clients are keyed by IP, or by key_header when it carries one of keys;
+    // any other value counts against the IP, so rotating it gains nothing.
+    void set_rate_limiter(std::shared_ptr<RateLimiter> limiter, const std::string& key_header = "",
+                          std::unordered_set<std::string> keys = {}) {
+        rate_limiter_ = std::move(limiter);
+        rate_limit_key_header_ = key_header;
+        rate_limit_keys_ = std::move(keys);
+    }
+    void exempt_from_rate_limit(const std::string& path) { rate_limit_exempt_.insert(path); }
+    
+    // Routed requests are admitted by priority (NORMAL unless set per path);
+    // shed requests get 503 with Retry-After before their handler runs
+    void set_admission_controller(std::shared_ptr<AdmissionController> admission) {
+        admission_ = std::move(admission);
+    }
+    void set_route_priority(const std::string& path, RequestPriority priority) { route_priorities_[path] = priority; }
+    // For handlers about to start work of this priority, e.g. a cold analysis
+    bool overloaded(RequestPriority priority = RequestPriority::BULK) const {
+        return admission_ && admission_->overloaded(priority);
+    }
+    HttpResponse overloaded_response() const;
     
     // Route registration
     void get(const std::string& path, RequestHandler handler);
@@ -115,47 +317,112 @@ public:
     void put(const std::string& path, RequestHandler handler);
     void del(const std::string& path, RequestHandler handler);
     void route(const std::string& method, const std::string& path, RequestHandler handler);
+    void get_async(const std::string& path, AsyncRequestHandler handler);
+    void route_async(const std::string& method, const std::string& path, AsyncRequestHandler handler);
     
     // Server control
     bool start();
     void stop();
     bool is_running() const { return running_; }
     int get_port() const { return port_; }
+    IoMode get_io_mode() const { return io_mode_; }
+    ThreadPoolStats get_worker_stats() const;
+    CompressionStats get_compression_stats() const;
+    void clear_compression_cache() { if (compression_cache_) compression_cache_->clear(); }
+    RateLimiterStats get_rate_limit_stats() const;
+    AdmissionStats get_admission_stats() const;
     
 private:
     int port_ = 8080;
     std::string static_dir_ = "./web";
     bool cors_enabled_ = true;
     size_t max_body_size_ = 10 * 1024 * 1024; // 10 MB
+    IoMode io_mode_ = IoMode::EVENT_LOOP;
+    int io_threads_ = 2;
+    bool reuse_port_ = false;
+    bool reuse_port_active_ = false;
+    bool pin_io_threads_ = false;
+    int thread_count_ = 4;
+    size_t queue_capacity_ = 1024;
+    int keep_alive_timeout_seconds_ = 5;    // 0 disables keep-alive
+    int max_requests_per_connection_ = 100;
+    int header_timeout_seconds_ = 10;
+    int body_timeout_seconds_ = 30;
+    int write_timeout_seconds_ = 30;
+    int compression_level_ = 6;
+    size_t compression_min_size_ = 1024;
+    std::shared_ptr<ResponseCache> compression_cache_;
+    std::chrono::seconds compression_cache_ttl_{0};
+    std::shared_ptr<RateLimiter> rate_limiter_;
+    std::string rate_limit_key_header_;
+    std::unordered_set<std::string> rate_limit_keys_;   // Header values given their own bucket
+    std::unordered_set<std::string> rate_limit_exempt_;
+    std::shared_ptr<AdmissionController> admission_;
+    std::unordered_map<std::string, RequestPriority> route_priorities_;
+    
+    std::atomic<uint64_t> compressed_responses_{0};
+    std::atomic<uint64_t> compression_bytes_in_{0};
+    std::atomic<uint64_t> compression_bytes_out_{0};
+    std::atomic<uint64_t> compression_cache_hits_{0};
     
     socket_t server_socket_ = INVALID_SOCKET_VALUE;
+    std::vector<socket_t> extra_listeners_;     // SO_REUSEPORT listeners for loops 1..N-1
     std::atomic<bool> running_{false};
-    std::vector<std::thread> worker_threads_;
-    std::mutex handlers_mutex_;
-    
-    struct RouteKey {
-        std::string method;
-        std::string path;
-        bool operator==(const RouteKey& other) const {
-            return method == other.method && path == other.path;
-        }
-    };
+    std::vector<std::thread> accept_threads_;
     
-    struct RouteKeyHash {
-        size_t operator()(const RouteKey& k) const {
-            return std::hash<std::string>()(k.method + ":" + k.path);
-        }
+    // Event-driven engine (defined in http_server.cpp)
+    struct Connection;
+    class EventLoop;
+    // Shared so a deferred response can still post to a loop after stop()
+    std::vector<std::shared_ptr<EventLoop>> event_loops_;
+    std::unique_ptr<ThreadPool> worker_pool_;
+    std::unique_ptr<StaticAssetCache> static_assets_;
+    
+    // Exactly one of the two handlers is set
+    struct Route {
+        RequestHandler handler;
+        AsyncRequestHandler async_handler;
+        std::string pattern;        // As registered; labels this route's metrics
     };
     
-    std::unordered_map<RouteKey, RequestHandler, RouteKeyHash> handlers_;
+    using RouteTable = Router<Route>;
+    
+    // Receives the finished response and whether the connection stays open
+    using RequestDone = std::function<void(HttpResponse response, bool keep_alive)>;
+    
+    // Copy-on-write routing: readers load the current snapshot without
+    // locking, writers rebuild the trie from route_definitions_ and publish
+    // the new pointer. Superseded snapshots stay alive until the server is
+    // destroyed so an in-flight lookup never sees a freed table;
+    // registrations are rare.
+    std::atomic<const RouteTable*> routes_{nullptr};
+    std::vector<std::unique_ptr<const RouteTable>> route_snapshots_;
+    std::vector<std::tuple<std::string, std::string, Route>> route_definitions_;
+    std::mutex routes_write_mutex_;
     
+    socket_t open_listener(bool reuse_port);
+    void close_listeners();
     void accept_connections();
-    void handle_client(socket_t client_socket, const std::string& client_ip);
-    HttpRequest parse_request(const std::string& raw);
-    std::string serialize_response(const HttpResponse& res);
-    HttpResponse serve_static_file(const std::string& path);
-    std::string get_mime_type(const std::string& path);
+    void handle_client(socket_t client_socket, const std::string& client_ip,
+                       std::chrono::steady_clock::duration queue_delay);
+    bool start_event_loops();
+    void add_route(const std::string& method, const std::string& path, Route route);
+    // Calls done once the response is ready, possibly later and on another thread
+    // queue_delay is how long the request waited for a worker (for admission control)
+    void process_request(std::string_view raw, const HttpRequestLayout& layout,
+                         const std::string& client_ip, bool keep_alive,
+                         std::chrono::steady_clock::duration queue_delay, RequestDone done);
+    void dispatch(const HttpRequestView& request, const std::string& client_ip,
+                  std::chrono::steady_clock::duration queue_delay, ResponseCallback respond);
+    // CORS, HTTP/1.0 stream draining, compression, then If-None-Match against the final ETag
+    void finish_response(HttpResponse& response, bool http11, std::string_view accept_encoding,
+                         std::string_view if_none_match);
+    void compress_response(HttpResponse& response, std::string_view accept_encoding);
+    // Status line and headers only; the body is written straight from the response
+    void render_head(const HttpResponse& res, bool keep_alive, std::string& head) const;
+    HttpResponse serve_static_file(const HttpRequestView& request);
     void add_cors_headers(HttpResponse& res);
+    bool rate_limited(const HttpRequestView& request, const std::string& client_ip, HttpResponse& refusal);
     
     // Platform-specific initialization
     bool init_sockets();
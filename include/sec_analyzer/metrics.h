@@ -0,0 +1,232 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Metrics Registry
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Counters, gauges and latency histograms exported in the Prometheus text
+ * format. Metrics are registered once, as families with fixed label names,
+ * and each label combination is a child looked up (or created) on first
+ * use; keep the returned reference to skip the lookup on later updates.
+ *
+ * Updates are lock-free: counters and histograms are split into per-thread
+ * shards (a thread always writes the same cache line, with relaxed atomics)
+ * and only a scrape adds the shards up. Histograms use log-linear buckets,
+ * four per power of two from 4 us to 68 s, so relative error stays under
+ * 25% at every scale.
+ */
+
+#ifndef SEC_ANALYZER_METRICS_H
+#define SEC_ANALYZER_METRICS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <array>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <functional>
+#include <initializer_list>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+namespace sec_analyzer {
+
+namespace metrics_detail {
+
+constexpr size_t SHARD_COUNT = 16;
+
+inline std::atomic<size_t> next_shard{0};
+
+// Threads are dealt shards round-robin on first use
+inline size_t shard_index() {
+    thread_local size_t index = next_shard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    return index;
+}
+
+} // namespace metrics_detail
+
+class Counter {
+public:
+    void inc(uint64_t amount = 1) {
+        slots_[metrics_detail::shard_index()].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+    uint64_t value() const;
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> value{0};
+    };
+    std::array<Slot, metrics_detail::SHARD_COUNT> slots_;
+};
+
+class Gauge {
+public:
+    void set(double value) { value_.store(value, std::memory_order_relaxed); }
+    void add(double delta);
+
+    // Sample from fn at scrape time instead (e.g. a queue depth owned elsewhere)
+    void set_function(std::function<double()> fn);
+    double value() const;
+
+private:
+    std::atomic<double> value_{0.0};
+    mutable std::mutex function_mutex_;
+    std::function<double()> function_;
+};
+
+class Histogram {
+public:
+    static constexpr int MIN_EXPONENT = 12;         // First bound: 2^12 ns = 4.1 us
+    static constexpr int MAX_EXPONENT = 36;         // Last bound: 2^36 ns = 68.7 s
+    static constexpr int SUB_BUCKETS = 4;           // Linear steps per power of two
+    static constexpr size_t BUCKET_COUNT = 1 + (MAX_EXPONENT - MIN_EXPONENT) * SUB_BUCKETS + 1;
+
+    void observe(std::chrono::nanoseconds duration);
+    void observe_seconds(double seconds) {
+        observe(std::chrono::nanoseconds(static_cast<int64_t>(seconds * 1e9)));
+    }
+
+    // Bucket for a duration; the last bucket is the overflow (+Inf)
+    static size_t bucket_of(uint64_t nanos);
+    // Inclusive upper bound of a finite bucket, in seconds
+    static double upper_bound(size_t bucket);
+
+    struct Snapshot {
+        std::array<uint64_t, BUCKET_COUNT> counts{};
+        uint64_t count = 0;
+        double sum_seconds = 0.0;
+    };
+    Snapshot snapshot() const;
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts{};
+        std::atomic<uint64_t> sum_nanos{0};
+    };
+    std::array<Shard, metrics_detail::SHARD_COUNT> shards_;
+};
+
+// Times a scope into a histogram
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() { histogram_.observe(std::chrono::steady_clock::now() - start_); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+class MetricFamilyBase {
+public:
+    MetricFamilyBase(std::string name, std::string help, std::vector<std::string> label_names)
+        : name_(std::move(name)), help_(std::move(help)), label_names_(std::move(label_names)) {}
+    virtual ~MetricFamilyBase() = default;
+
+    virtual const char* type() const = 0;
+    virtual void render(std::string& out) const = 0;
+    const std::string& help() const { return help_; }
+
+protected:
+    std::string name_;
+    std::string help_;
+    std::vector<std::string> label_names_;
+
+    // {a="x",b="y"} for these label values, plus an optional extra pair (le for buckets)
+    std::string label_text(const std::vector<std::string>& values,
+                           std::string_view extra_name = {}, std::string_view extra_value = {}) const;
+};
+
+template<typename M>
+class MetricFamily : public MetricFamilyBase {
+public:
+    using MetricFamilyBase::MetricFamilyBase;
+
+    // Child for these label values, given in the family's label order
+    M& with(std::initializer_list<std::string_view> values) {
+        std::string key;
+        for (std::string_view value : values) {
+            key.append(value);
+            key.push_back('\x1f');
+        }
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = children_.find(key);
+            if (it != children_.end()) return *it->second.metric;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto [it, inserted] = children_.try_emplace(key);
+        if (inserted) {
+            it->second.label_values.assign(values.begin(), values.end());
+            it->second.metric = std::make_unique<M>();
+        }
+        return *it->second.metric;
+    }
+
+    const char* type() const override;
+    void render(std::string& out) const override;
+
+private:
+    struct Child {
+        std::vector<std::string> label_values;
+        std::unique_ptr<M> metric;
+    };
+    mutable std::shared_mutex mutex_;
+    std::map<std::string, Child> children_;
+};
+
+// Defined per metric type in metrics.cpp
+template<> const char* MetricFamily<Counter>::type() const;
+template<> const char* MetricFamily<Gauge>::type() const;
+template<> const char* MetricFamily<Histogram>::type() const;
+template<> void MetricFamily<Counter>::render(std::string& out) const;
+template<> void MetricFamily<Gauge>::render(std::string& out) const;
+template<> void MetricFamily<Histogram>::render(std::string& out) const;
+
+using CounterFamily = MetricFamily<Counter>;
+using GaugeFamily = MetricFamily<Gauge>;
+using HistogramFamily = MetricFamily<Histogram>;
+
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance() {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    /**
+     * Register (or fetch the already registered) family. Throws
+     * std::logic_error if the name exists with another type.
+     */
+    CounterFamily& counter(const std::string& name, const std::string& help,
+                           std::vector<std::string> label_names = {});
+    GaugeFamily& gauge(const std::string& name, const std::string& help,
+                       std::vector<std::string> label_names = {});
+    HistogramFamily& histogram(const std::string& name, const std::string& help,
+                               std::vector<std::string> label_names = {});
+
+    // Prometheus text exposition format 0.0.4, families sorted by name
+    std::string render() const;
+
+private:
+    MetricsRegistry() = default;
+
+    template<typename F>
+    F& family(const std::string& name, const std::string& help, std::vector<std::string> label_names);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<MetricFamilyBase>> families_;
+};
+
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_METRICS_H
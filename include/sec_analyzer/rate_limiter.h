@@ -0,0 +1,96 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Client Rate Limiter
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Per-client token buckets, implemented as GCRA: each client is a single
+ * atomic "theoretical arrival time", so the bucket for a known client is
+ * updated with one compare-and-swap under a shared shard lock. Clients are
+ * spread over independent shards; the exclusive lock is only taken to add
+ * a client or to sweep out clients whose buckets have refilled completely
+ * (dropping those is exact, they would start full anyway).
+ */
+
+#ifndef SEC_ANALYZER_RATE_LIMITER_H
+#define SEC_ANALYZER_RATE_LIMITER_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <shared_mutex>
+#include <atomic>
+#include <array>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+
+namespace sec_analyzer {
+
+struct RateLimitDecision {
+    bool allowed = true;
+    int retry_after_seconds = 0;    // Set when refused
+};
+
+struct RateLimiterStats {
+    uint64_t allowed = 0;
+    uint64_t limited = 0;
+    uint64_t evicted = 0;           // Dropped at the client cap before refilling
+    size_t clients = 0;             // Buckets currently tracked
+};
+
+class RateLimiter {
+public:
+    static constexpr size_t SHARD_COUNT = 64;
+    static constexpr size_t DEFAULT_MAX_CLIENTS = 100000;
+
+    /**
+     * Allow `per_minute` requests per client on average, with bursts of up
+     * to `burst` (defaults to per_minute). At most `max_clients` buckets are
+     * kept; past that the client closest to a full bucket is forgotten.
+     */
+    explicit RateLimiter(int per_minute, int burst = 0, size_t max_clients = DEFAULT_MAX_CLIENTS);
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    // Take one token from the client's bucket
+    RateLimitDecision acquire(std::string_view client);
+
+    RateLimiterStats stats() const;
+    int per_minute() const { return per_minute_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view key) const { return std::hash<std::string_view>()(key); }
+    };
+
+    // Theoretical arrival time in steady-clock nanoseconds; <= now means full
+    using BucketMap = std::unordered_map<std::string, std::atomic<int64_t>, KeyHash, std::equal_to<>>;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        BucketMap buckets;
+        std::atomic<int64_t> next_sweep{0};
+    };
+
+    int per_minute_;
+    int64_t interval_ns_;           // Time to earn one token
+    int64_t tolerance_ns_;          // How far ahead of now a bucket may run (burst - 1 tokens)
+    size_t max_per_shard_;
+    std::unique_ptr<std::array<Shard, SHARD_COUNT>> shards_;
+
+    std::atomic<uint64_t> allowed_{0};
+    std::atomic<uint64_t> limited_{0};
+    std::atomic<uint64_t> evicted_{0};
+
+    static int64_t now_ns();
+    RateLimitDecision take(std::atomic<int64_t>& tat, int64_t now);
+    void sweep(Shard& shard, int64_t now);
+};
+
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_RATE_LIMITER_H
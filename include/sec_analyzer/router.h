@@ -0,0 +1,224 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Request Router
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Radix-trie path router. Patterns are literal paths with optional
+ * parameters: a {name} segment matches one non-empty segment, as in
+ * /api/company/{cik}/filings, and a final *name segment matches the rest
+ * of the path (possibly empty).
+ * Literal edges win over parameters, parameters over wildcards, with
+ * backtracking when a more specific branch fails further down. Handlers
+ * are stored per method at the node where a pattern ends. Lookup walks
+ * the request path in place and records parameters as views into it,
+ * so it never allocates.
+ */
+
+#ifndef SEC_ANALYZER_ROUTER_H
+#define SEC_ANALYZER_ROUTER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+namespace sec_analyzer {
+
+// Parameters captured by a lookup; views into the pattern and the request path
+struct PathParams {
+    static constexpr size_t MAX_PARAMS = 8;
+
+    std::array<std::pair<std::string_view, std::string_view>, MAX_PARAMS> items;
+    size_t count = 0;
+
+    const std::pair<std::string_view, std::string_view>* begin() const { return items.data(); }
+    const std::pair<std::string_view, std::string_view>* end() const { return items.data() + count; }
+};
+
+template<typename T>
+class Router {
+public:
+    // Handlers registered for one path pattern, by method
+    using Endpoint = std::vector<std::pair<std::string, T>>;
+
+    struct Match {
+        const Endpoint* endpoint = nullptr;     // Path matched; null if nothing did
+        const T* value = nullptr;               // Null if the method is not registered (405)
+    };
+
+    Router() : root_(std::make_unique<Node>()) {}
+
+    /**
+     * Register value for method + pattern, replacing an earlier registration.
+     * Throws std::invalid_argument for malformed patterns, or a parameter
+     * whose name differs from one already registered at the same position.
+     */
+    void add(const std::string& method, const std::string& pattern, T value) {
+        if (pattern.empty() || pattern[0] != '/') {
+            throw std::invalid_argument("Route must start with '/': " + pattern);
+        }
+
+        Node* node = root_.get();
+        size_t params = 0;
+        size_t pos = 0;
+        while (pos < pattern.size()) {
+            size_t special = pattern.find_first_of("{*", pos);
+            node = insert_literal(node, std::string_view(pattern).substr(pos, special - pos));
+            if (special == std::string::npos) break;
+
+            if (pattern[special - 1] != '/' || ++params > PathParams::MAX_PARAMS) {
+                throw std::invalid_argument("Invalid parameter in route: " + pattern);
+            }
+
+            if (pattern[special] == '*') {
+                std::string name = pattern.substr(special + 1);
+                if (name.find_first_of("/{}*") != std::string::npos) {
+                    throw std::invalid_argument("Wildcard must end the route: " + pattern);
+                }
+                node = attach(node->wildcard, node->wildcard_name, name, pattern);
+                break;
+            }
+
+            size_t close = pattern.find('}', special);
+            if (close == std::string::npos || close == special + 1 ||
+                (close + 1 < pattern.size() && pattern[close + 1] != '/')) {
+                throw std::invalid_argument("Invalid parameter in route: " + pattern);
+            }
+            std::string name = pattern.substr(special + 1, close - special - 1);
+            if (name.find_first_of("/{*") != std::string::npos) {
+                throw std::invalid_argument("Invalid parameter in route: " + pattern);
+            }
+            node = attach(node->param, node->param_name, name, pattern);
+            pos = close + 1;
+        }
+
+        for (auto& [registered, existing] : node->endpoint) {
+            if (registered == method) {
+                existing = std::move(value);
+                return;
+            }
+        }
+        node->endpoint.emplace_back(method, std::move(value));
+    }
+
+    // Resolve a request; params are only valid while path (and this router) live
+    Match find(std::string_view method, std::string_view path, PathParams& params) const {
+        Match match;
+        params.count = 0;
+        const Node* node = match_node(root_.get(), path, params);
+        if (!node) return match;
+
+        match.endpoint = &node->endpoint;
+        for (const auto& [registered, value] : node->endpoint) {
+            if (registered == method) {
+                match.value = &value;
+                break;
+            }
+        }
+        return match;
+    }
+
+private:
+    struct Node {
+        std::string prefix;                         // Literal bytes consumed by this node
+        std::string indices;                        // First byte of each literal child
+        std::vector<std::unique_ptr<Node>> children;
+        std::unique_ptr<Node> param;                // {name}: one segment, then continues
+        std::string param_name;
+        std::unique_ptr<Node> wildcard;             // *name: the rest of the path
+        std::string wildcard_name;
+        Endpoint endpoint;
+    };
+
+    std::unique_ptr<Node> root_;
+
+    static Node* attach(std::unique_ptr<Node>& slot, std::string& slot_name,
+                        const std::string& name, const std::string& pattern) {
+        if (!slot) {
+            slot = std::make_unique<Node>();
+            slot_name = name;
+        } else if (slot_name != name) {
+            throw std::invalid_argument("Conflicting parameter name '" + name + "' in route: " + pattern);
+        }
+        return slot.get();
+    }
+
+    // Walk/extend the literal edges below node, splitting an edge where the text diverges
+    static Node* insert_literal(Node* node, std::string_view text) {
+        while (!text.empty()) {
+            size_t index = node->indices.find(text[0]);
+            if (index == std::string::npos) {
+                auto child = std::make_unique<Node>();
+                child->prefix = std::string(text);
+                node->indices.push_back(text[0]);
+                node->children.push_back(std::move(child));
+                return node->children.back().get();
+            }
+
+            std::unique_ptr<Node>& slot = node->children[index];
+            size_t common = 0;
+            while (common < text.size() && common < slot->prefix.size() &&
+                   text[common] == slot->prefix[common]) {
+                ++common;
+            }
+
+            if (common < slot->prefix.size()) {
+                auto split = std::make_unique<Node>();
+                split->prefix = slot->prefix.substr(0, common);
+                slot->prefix.erase(0, common);
+                split->indices.push_back(slot->prefix[0]);
+                split->children.push_back(std::move(slot));
+                slot = std::move(split);
+            }
+
+            node = slot.get();
+            text.remove_prefix(common);
+        }
+        return node;
+    }
+
+    // node's own prefix is already consumed; path is what remains
+    static const Node* match_node(const Node* node, std::string_view path, PathParams& params) {
+        if (path.empty() && !node->endpoint.empty()) {
+            return node;
+        }
+
+        if (!path.empty()) {
+            size_t index = node->indices.find(path[0]);
+            if (index != std::string::npos) {
+                const Node* child = node->children[index].get();
+                if (path.substr(0, child->prefix.size()) == child->prefix) {
+                    if (const Node* found = match_node(child, path.substr(child->prefix.size()), params)) {
+                        return found;
+                    }
+                }
+            }
+
+            if (node->param) {
+                size_t end = std::min(path.find('/'), path.size());
+                if (end > 0) {
+                    size_t saved = params.count;
+                    params.items[params.count++] = {node->param_name, path.substr(0, end)};
+                    if (const Node* found = match_node(node->param.get(), path.substr(end), params)) {
+                        return found;
+                    }
+                    params.count = saved;
+                }
+            }
+        }
+
+        if (node->wildcard && !node->wildcard->endpoint.empty()) {
+            params.items[params.count++] = {node->wildcard_name, path};
+            return node->wildcard.get();
+        }
+        return nullptr;
+    }
+};
+
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_ROUTER_H
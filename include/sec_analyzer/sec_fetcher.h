@@ -11,10 +11,16 @@
 
 #include "types.h"
 #include "cache.h"
+#include "single_flight.h"
+#include "http_client.h"
+#include "fact_index.h"
+#include "company_directory.h"
 #include <string>
 #include <vector>
 #include <optional>
 #include <functional>
+#include <memory>
+#include <memory>
 
 namespace sec_analyzer {
 
@@ -27,12 +33,20 @@ public:
     // Configuration
     void set_user_agent(const std::string& ua) { user_agent_ = ua; }
     void set_rate_limit_ms(int ms) { rate_limit_ms_ = ms; }
-    void set_cache(Cache<std::string>* cache) { cache_ = cache; }
-    void set_timeout(int seconds) { timeout_seconds_ = seconds; }
+    // Cache SEC responses, fresh for the per-endpoint lifetimes in config, revalidated after
+    void set_cache(std::shared_ptr<ResponseCache> cache, const SecCacheConfig& config = {});
+    void set_timeout(int seconds);
+    // Fetch from this origin instead of SEC EDGAR, e.g. a local stand-in server
+    void set_base_url(const std::string& base_url);
     
-    // Company lookup
-    std::optional<CompanyInfo> lookup_company_by_ticker(const std::string& ticker);
-    std::optional<CompanyInfo> lookup_company_by_cik(const std::string& cik);
+    // Keep the ticker directory resident, reloading it every interval
+    void start_directory_refresh(std::chrono::seconds interval) { directory_.start(interval); }
+    void stop_directory_refresh() { directory_.stop(); }
+    
+    // Company lookup; tickers and search are answered from the resident directory.
+    // Failures are described in *error when given; nothing is kept between calls
+    std::optional<CompanyInfo> lookup_company_by_ticker(const std::string& ticker, std::string* error = nullptr);
+    std::optional<CompanyInfo> lookup_company_by_cik(const std::string& cik, std::string* error = nullptr);
     std::vector<CompanyInfo> search_companies(const std::string& query);
     
     // Filing retrieval
@@ -42,33 +56,61 @@ public:
     
     // Financial data extraction
     std::optional<FinancialData> get_financial_data(const Filing& filing);
-    std::vector<FinancialData> get_all_financial_data(const std::string& cik, int years = 5);
+    // on_filing(done, total) is called after each filing's data is extracted
+    std::vector<FinancialData> get_all_financial_data(const std::string& cik, int years = 5,
+        const std::function<void(size_t, size_t)>& on_filing = nullptr);
     
-    // Raw data access
-    std::optional<std::string> fetch_url(const std::string& url);
-    std::optional<std::string> fetch_json(const std::string& endpoint);
+    // Raw data access; concurrent fetches of the same URL share one request,
+    // and callers share the cached body rather than copying it. Null on failure.
+    std::shared_ptr<const std::string> fetch_url(const std::string& url, std::string* error = nullptr);
+    std::shared_ptr<const std::string> fetch_json(const std::string& endpoint, std::string* error = nullptr);
     
     // CIK utilities
     static std::string normalize_cik(const std::string& cik);
     std::string ticker_to_cik(const std::string& ticker);
     
-    // Error handling
-    std::string get_last_error() const { return last_error_; }
-    bool has_error() const { return !last_error_.empty(); }
-    void clear_error() { last_error_.clear(); }
+    SingleFlightStats get_fetch_stats() const { return fetch_flights_.stats(); }
+    HttpClientStats get_http_stats() const;
+    CompanyDirectoryStats get_directory_stats() const { return directory_.stats(); }
+    ResponseCacheStats get_cache_stats() const { return cache_ ? cache_->stats() : ResponseCacheStats{}; }
+    void clear_cache() { if (cache_) cache_->clear(); }
 
 private:
     std::string user_agent_;
     int rate_limit_ms_ = 100;
     int timeout_seconds_ = 30;
-    Cache<std::string>* cache_ = nullptr;
-    std::string last_error_;
+    std::shared_ptr<ResponseCache> cache_;
+    SecCacheConfig cache_config_;
     
     std::chrono::steady_clock::time_point last_request_time_;
     std::mutex rate_limit_mutex_;
     
-    // HTTP implementation
-    std::optional<std::string> http_get(const std::string& url);
+    // Body of a fetch, or why there is none; shared by coalesced callers
+    struct FetchResult {
+        std::shared_ptr<const std::string> body;
+        std::string error;
+    };
+    SingleFlight<FetchResult> fetch_flights_;
+#ifndef _WIN32
+    HttpClient http_;
+#endif
+    CompanyDirectory directory_;    // Last member: its refresher calls into the others
+    
+    // company_tickers.json, parsed, for directory_
+    std::optional<JsonValue> load_company_tickers(std::string& error);
+    
+    // A response that arrived; body is only read for 200
+    struct HttpResult {
+        long status = 0;
+        std::string body;
+        std::string etag;
+        std::string last_modified;
+    };
+    
+    // HTTP implementation; nullopt (and error) if no response arrived
+    std::optional<HttpResult> http_get(const std::string& url, const HttpHeaderList& headers, std::string& error);
+    FetchResult fetch_remote(const std::string& url);
+    std::chrono::seconds cache_ttl(const std::string& url) const;
     void rate_limit();
     
     // Parsing helpers
@@ -76,6 +118,10 @@ private:
     std::vector<Filing> parse_filings(const std::string& json, const std::string& cik);
     FinancialData parse_financial_data(const std::string& content, const Filing& filing);
     
+    // Index over a company's XBRL facts document; error is set if it failed to parse
+    std::optional<FactIndex> get_company_facts(const std::string& cik, std::string& error);
+    FinancialData extract_financial_data(const FactIndex& facts, const Filing& filing);
+    
     // XBRL parsing
     double extract_xbrl_value(const std::string& content, const std::string& xbrl_concept);
     std::vector<std::string> get_xbrl_concepts();
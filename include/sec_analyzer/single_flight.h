@@ -0,0 +1,117 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Single-Flight Request Coalescing
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Collapses concurrent requests for the same key into one computation.
+ * The first caller for a key leads and produces the value; everyone who
+ * arrives while it is in flight gets a copy of that value instead of
+ * repeating the work. Nothing is kept once the flight lands, so this
+ * complements a cache rather than replacing it.
+ */
+
+#ifndef SEC_ANALYZER_SINGLE_FLIGHT_H
+#define SEC_ANALYZER_SINGLE_FLIGHT_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+namespace sec_analyzer {
+
+struct SingleFlightStats {
+    uint64_t leaders = 0;           // Computations actually run
+    uint64_t shared = 0;            // Callers served by another caller's computation
+    size_t in_flight = 0;           // Keys currently being computed
+};
+
+template<typename T>
+class SingleFlight {
+public:
+    using Callback = std::function<void(const T&)>;
+
+    SingleFlight() = default;
+    SingleFlight(const SingleFlight&) = delete;
+    SingleFlight& operator=(const SingleFlight&) = delete;
+
+    /**
+     * Asynchronous form: queue callback for key's result. Returns true if
+     * the caller is the leader and must eventually call finish(key, value),
+     * from any thread; the callback of every joined caller, leader included,
+     * then runs on that thread.
+     */
+    bool join(const std::string& key, Callback callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto [it, inserted] = flights_.try_emplace(key);
+        it->second.push_back(std::move(callback));
+        if (inserted) {
+            leaders_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            shared_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return inserted;
+    }
+
+    // Land key's flight: hand value to every waiting callback
+    void finish(const std::string& key, const T& value) {
+        std::vector<Callback> waiters;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = flights_.find(key);
+            if (it == flights_.end()) return;
+            waiters = std::move(it->second);
+            flights_.erase(it);
+        }
+        for (auto& waiter : waiters) {
+            waiter(value);
+        }
+    }
+
+    /**
+     * Blocking form: run fn unless an identical call is already in flight,
+     * in which case wait for its result. If the leader's fn throws, the
+     * leader sees the exception and the waiters receive T{}.
+     */
+    T run(const std::string& key, const std::function<T()>& fn) {
+        std::promise<T> result;
+        std::future<T> future = result.get_future();
+        bool leader = join(key, [&result](const T& value) { result.set_value(value); });
+        if (!leader) {
+            return future.get();
+        }
+
+        T value;
+        try {
+            value = fn();
+        } catch (...) {
+            finish(key, T{});
+            throw;
+        }
+        finish(key, value);
+        return value;
+    }
+
+    SingleFlightStats stats() const {
+        SingleFlightStats stats;
+        stats.leaders = leaders_.load(std::memory_order_relaxed);
+        stats.shared = shared_.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.in_flight = flights_.size();
+        return stats;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::vector<Callback>> flights_;
+    std::atomic<uint64_t> leaders_{0};
+    std::atomic<uint64_t> shared_{0};
+};
+
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_SINGLE_FLIGHT_H
@@ -0,0 +1,83 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Static Asset Cache
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * In-memory index of the web directory. Each asset carries its MIME type,
+ * a strong ETag and, for compressible text, a precompressed gzip variant.
+ * Files larger than MAX_CACHED_FILE_SIZE are indexed but not loaded; the
+ * server streams them from disk with sendfile. The index is rebuilt when
+ * the directory changes (inotify on Linux, a periodic rescan elsewhere)
+ * and swapped in whole, so readers never see a half-built index.
+ */
+
+#ifndef SEC_ANALYZER_STATIC_ASSETS_H
+#define SEC_ANALYZER_STATIC_ASSETS_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+
+namespace sec_analyzer {
+
+struct StaticAsset {
+    std::string file_path;                          // Location on disk
+    std::string content_type;
+    std::string etag;                               // Quoted, ready for the ETag header
+    size_t size = 0;
+    std::shared_ptr<const std::string> body;        // Null if too large to cache
+    std::shared_ptr<const std::string> gzip_body;   // Null if not worth compressing
+};
+
+class StaticAssetCache {
+public:
+    static constexpr size_t MAX_CACHED_FILE_SIZE = 1024 * 1024;
+    static constexpr size_t MIN_COMPRESS_SIZE = 256;
+
+    explicit StaticAssetCache(std::string root);
+    ~StaticAssetCache();
+
+    StaticAssetCache(const StaticAssetCache&) = delete;
+    StaticAssetCache& operator=(const StaticAssetCache&) = delete;
+
+    // Load the directory and start watching it for changes
+    void start();
+    void stop();
+
+    // Asset for a URL path such as "/js/app.js"; null if not indexed
+    std::shared_ptr<const StaticAsset> find(std::string_view url_path) const;
+    size_t size() const;
+
+    static std::string mime_type(const std::string& path);
+
+    // ETag for an uncached file, derived from its size and modification time
+    static std::string file_etag(size_t size, long long mtime);
+
+private:
+    using AssetMap = std::unordered_map<std::string, std::shared_ptr<const StaticAsset>>;
+
+    std::string root_;
+    std::shared_ptr<const AssetMap> assets_;
+    mutable std::mutex mutex_;          // Guards assets_ pointer swaps
+
+    std::atomic<bool> running_{false};
+    std::thread watcher_;
+    std::mutex watcher_mutex_;
+    std::condition_variable watcher_cv_;
+    int inotify_fd_ = -1;
+
+    std::shared_ptr<const AssetMap> build() const;
+    void reload();
+    void watch_loop();
+    void add_watches();
+    std::string scan_signature() const;
+};
+
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_STATIC_ASSETS_H
@@ -0,0 +1,101 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Worker Thread Pool
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Bounded work-stealing pool used to run request handlers off the I/O
+ * threads. External submissions go through a bounded global queue; tasks
+ * submitted from inside a worker go to that worker's own deque, and idle
+ * workers steal from the front of their peers' deques.
+ */
+
+#ifndef SEC_ANALYZER_THREAD_POOL_H
+#define SEC_ANALYZER_THREAD_POOL_H
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace sec_analyzer {
+
+struct ThreadPoolStats {
+    size_t thread_count = 0;
+    size_t queue_depth = 0;         // Tasks waiting (global + per-worker)
+    size_t queue_capacity = 0;
+    size_t active = 0;              // Tasks currently executing
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    uint64_t rejected = 0;          // Refused because the queue was full
+    uint64_t steals = 0;
+    double avg_wait_ms = 0;         // Enqueue-to-start latency
+    double max_wait_ms = 0;
+};
+
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t thread_count = 0, size_t queue_capacity = 1024);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Lifecycle
+    void start();
+    void shutdown();
+    bool is_running() const { return running_; }
+
+    // Queue a task; returns false if the pool is stopped or the queue is full
+    bool submit(Task task);
+
+    size_t thread_count() const { return thread_count_; }
+    size_t queue_depth() const { return pending_; }
+    ThreadPoolStats stats() const;
+
+private:
+    struct Item {
+        Task task;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Item> deque;
+    };
+
+    size_t thread_count_;
+    size_t queue_capacity_;
+    std::atomic<bool> running_{false};
+    std::vector<std::thread> threads_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::deque<Item> global_;
+    mutable std::mutex mutex_;      // Guards global_ and worker sleep/wake
+    std::condition_variable cv_;
+
+    // Statistics
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> active_{0};
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> steals_{0};
+    std::atomic<uint64_t> total_wait_us_{0};
+    std::atomic<uint64_t> max_wait_us_{0};
+
+    void worker_loop(size_t index);
+    bool try_pop(size_t index, Item& item);
+    void run_item(Item& item);
+};
+
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_THREAD_POOL_H
@@ -0,0 +1,68 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Timer Wheel
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ *
+ * Hashed timing wheel for connection deadlines. Timers are intrusive
+ * (embedded in their owner), so arming, re-arming and cancelling are O(1)
+ * list splices with no allocation. A timer lives in the slot for its
+ * expiry tick modulo the wheel size; deadlines further out than one
+ * revolution simply stay put until their tick comes round. Not
+ * thread-safe: each event loop owns one wheel.
+ */
+
+#ifndef SEC_ANALYZER_TIMER_WHEEL_H
+#define SEC_ANALYZER_TIMER_WHEEL_H
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+namespace sec_analyzer {
+
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Timer {
+        Timer* prev = nullptr;
+        Timer* next = nullptr;
+        uint64_t expires = 0;       // Absolute tick
+        int data = -1;              // Owner's tag, e.g. the socket
+        bool armed() const { return prev != nullptr; }
+    };
+
+    explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(100),
+                        size_t slot_count = 512);
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Arm (or re-arm) timer to fire after delay, rounded up to a whole tick
+    void schedule(Timer& timer, std::chrono::milliseconds delay);
+    void cancel(Timer& timer);
+
+    /**
+     * Collect every timer due by now, unlinked, into expired. Callers
+     * handle them afterwards, so handlers may re-arm or cancel freely.
+     */
+    void advance(Clock::time_point now, std::vector<Timer*>& expired);
+
+    size_t size() const { return armed_; }
+    std::chrono::milliseconds tick() const { return tick_; }
+
+private:
+    std::chrono::milliseconds tick_;
+    std::vector<Timer> slots_;      // List heads; each slot is a circular list
+    size_t mask_;
+    Clock::time_point epoch_;
+    uint64_t current_ = 0;          // Last tick processed
+    size_t armed_ = 0;
+
+    uint64_t tick_of(Clock::time_point time) const;
+};
+
+} // namespace sec_analyzer
+
+#endif // SEC_ANALYZER_TIMER_WHEEL_H
@@ -70,13 +70,48 @@ struct RiskWeights {
     }
 };
 
+// SEC response cache: byte budget and per-endpoint freshness lifetimes (seconds)
+struct SecCacheConfig {
+    int max_mb = 256;               // 0 disables the cache
+    int tickers_ttl = 3600;         // company_tickers.json
+    int submissions_ttl = 600;      // Filing lists change whenever the company files
+    int company_facts_ttl = 3600;
+    int documents_ttl = 86400;      // Archived filing documents never change
+};
+
 struct ServerConfig {
     int port = 8080;
-    int thread_count = 4;
+    int thread_count = 4;           // Request worker pool size
+    int worker_queue_size = 1024;   // Bounded worker submission queue
+    int io_threads = 2;             // epoll event loop threads
+    bool reuse_port = false;        // One SO_REUSEPORT listener per event loop
+    bool pin_io_threads = false;    // Pin each event loop thread to its own core
+    int analysis_threads = 2;       // Executor for deferred /api/analyze work
+    int analysis_queue_size = 4096; // Analyses waiting for that executor
+    bool blocking_io = false;       // Fall back to thread-per-connection I/O
+    int keep_alive_timeout_seconds = 5;
+    int max_requests_per_connection = 100;
+    int header_timeout_seconds = 10; // Request line + headers must arrive within this
+    int body_timeout_seconds = 30;  // Longest gap between body bytes
+    int write_timeout_seconds = 30; // Longest a client may stall reading a response
+    int max_body_size_kb = 10240;   // Larger request bodies get 413
+    int compression_level = 6;      // gzip/deflate level, 0 disables
+    int compression_min_size = 1024; // Smaller responses are sent uncompressed
+    int compression_cache_mb = 32;  // Compressed variants kept for reuse, 0 disables
     int cache_ttl_seconds = 3600;
-    int rate_limit_per_minute = 60;
+    int rate_limit_per_minute = 60; // Per-client API budget, 0 disables
+    int rate_limit_burst = 0;       // Requests allowed at once, 0 = rate_limit_per_minute
+    std::string rate_limit_key_header = ""; // Key clients by this header when it holds a listed key
+    std::vector<std::string> rate_limit_keys;  // Values of rate_limit_key_header with their own bucket
+    int max_in_flight = 512;        // Admitted requests not yet answered, 0 = no limit
+    int queue_target_ms = 5;        // Acceptable wait for a worker, 0 disables delay shedding
+    int queue_interval_ms = 100;    // How long waits may stay above target before shedding
+    int overload_retry_after = 1;   // Retry-After (seconds) on shed requests
     int request_delay_ms = 100;
     std::string sec_user_agent = "SECFraudAnalyzer/2.1.2 (educational@example.com)";
+    std::string sec_base_url = "";     // Fetch from this origin instead of SEC EDGAR (testing)
+    int directory_refresh_seconds = 86400; // Reload the ticker directory this often, 0 = never
+    SecCacheConfig sec_cache;
     std::string static_dir = "./web";
     std::string cache_dir = "./cache";
     std::string log_file = "";
@@ -297,6 +332,7 @@ struct AnalysisResult {
     // Metadata
     std::string analysis_timestamp;
     std::string version = "2.1.2";
+    std::string error;              // Why no analysis was produced; empty on success
 };
 
 // Utility functions
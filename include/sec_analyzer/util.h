@@ -10,6 +10,7 @@
 #define SEC_ANALYZER_UTIL_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <sstream>
 #include <iomanip>
@@ -18,6 +19,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <cstdint>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -54,6 +56,16 @@ inline std::string to_lower(const std::string& str) {
     return result;
 }
 
+inline bool iequals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
 inline std::vector<std::string> split(const std::string& str, char delimiter) {
     std::vector<std::string> tokens;
     std::stringstream ss(str);
@@ -308,6 +320,36 @@ inline std::string html_escape(const std::string& str) {
     return result;
 }
 
+/**
+ * Content hashing (FNV-1a, 64-bit) for ETags and cache variant keys
+ */
+inline uint64_t fnv1a64(std::string_view data) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline std::string to_hex(uint64_t value) {
+    std::ostringstream oss;
+    oss << std::hex << value;
+    return oss.str();
+}
+
+// Strong ETag from one or two hex parts: "a" or "a-b"
+inline std::string quoted_etag(std::string_view part, std::string_view second = {}) {
+    std::string tag;
+    tag.reserve(part.size() + second.size() + 3);
+    tag.append(1, '"').append(part);
+    if (!second.empty()) {
+        tag.append(1, '-').append(second);
+    }
+    tag.append(1, '"');
+    return tag;
+}
+
 } // namespace util
 } // namespace sec_analyzer
 
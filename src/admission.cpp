@@ -0,0 +1,83 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Admission Control Implementation
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ */
+
+#include <sec_analyzer/admission.h>
+
+#include <algorithm>
+
+namespace sec_analyzer {
+
+AdmissionController::AdmissionController(AdmissionConfig config)
+    : config_(config),
+      target_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(config.target_delay).count()),
+      interval_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(config.interval).count()) {}
+
+int64_t AdmissionController::now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+bool AdmissionController::standing_queue(int64_t now) const {
+    int64_t since = above_target_since_ns_.load(std::memory_order_relaxed);
+    return target_ns_ > 0 && since != 0 && now - since > interval_ns_;
+}
+
+size_t AdmissionController::limit_for(RequestPriority priority) const {
+    if (config_.max_in_flight == 0) return SIZE_MAX;
+    if (priority == RequestPriority::BULK) return std::max<size_t>(1, config_.max_in_flight / 2);
+    return config_.max_in_flight;
+}
+
+bool AdmissionController::admit(RequestPriority priority, Clock::duration queue_delay) {
+    int64_t delay = std::chrono::duration_cast<std::chrono::nanoseconds>(queue_delay).count();
+    int64_t now = now_ns();
+    last_delay_ns_.store(delay, std::memory_order_relaxed);
+    if (delay < target_ns_) {
+        above_target_since_ns_.store(0, std::memory_order_relaxed);
+    } else if (target_ns_ > 0) {
+        int64_t none = 0;
+        above_target_since_ns_.compare_exchange_strong(none, now, std::memory_order_relaxed);
+    }
+
+    if (priority != RequestPriority::CRITICAL) {
+        // Serving a request that is already late only makes the next one later
+        if (delay >= target_ns_ && standing_queue(now)) {
+            shed_queue_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (in_flight_.fetch_add(1, std::memory_order_relaxed) >= limit_for(priority)) {
+            in_flight_.fetch_sub(1, std::memory_order_relaxed);
+            shed_in_flight_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } else {
+        in_flight_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    admitted_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void AdmissionController::release() {
+    in_flight_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool AdmissionController::overloaded(RequestPriority priority) const {
+    if (priority == RequestPriority::CRITICAL) return false;
+    return standing_queue(now_ns()) || in_flight_.load(std::memory_order_relaxed) >= limit_for(priority);
+}
+
+AdmissionStats AdmissionController::stats() const {
+    AdmissionStats stats;
+    stats.admitted = admitted_.load(std::memory_order_relaxed);
+    stats.shed_in_flight = shed_in_flight_.load(std::memory_order_relaxed);
+    stats.shed_queue = shed_queue_.load(std::memory_order_relaxed);
+    stats.in_flight = in_flight_.load(std::memory_order_relaxed);
+    stats.queue_delay_ms = static_cast<double>(last_delay_ns_.load(std::memory_order_relaxed)) / 1e6;
+    stats.standing_queue = standing_queue(now_ns());
+    return stats;
+}
+
+} // namespace sec_analyzer
@@ -7,6 +7,7 @@
 #include <sec_analyzer/analyzer.h>
 #include <sec_analyzer/logger.h>
 #include <sec_analyzer/util.h>
+#include <sec_analyzer/metrics.h>
 
 namespace sec_analyzer {
 
@@ -24,53 +25,86 @@ FraudAnalyzer::FraudAnalyzer(const RiskWeights& weights) : FraudAnalyzer() {
 
 FraudAnalyzer::~FraudAnalyzer() = default;
 
-AnalysisResult FraudAnalyzer::analyze_by_ticker(const std::string& ticker, int years) {
+namespace {
+
+void report(const ProgressCallback& progress, const std::string& stage, const std::string& detail,
+            size_t current = 0, size_t total = 0) {
+    if (progress) {
+        progress(AnalysisProgress{stage, detail, static_cast<int>(current), static_cast<int>(total)});
+    }
+}
+
+// Adapts a ProgressCallback to SECFetcher's per-filing hook
+std::function<void(size_t, size_t)> filing_reporter(const ProgressCallback& progress) {
+    if (!progress) return nullptr;
+    return [&progress](size_t done, size_t total) {
+        report(progress, "extract", "Extracted financial data", done, total);
+    };
+}
+
+// Runs one model's calculation, timed into model_compute_duration_seconds{model}
+template<typename F>
+auto timed(std::string_view model, F&& compute) {
+    static auto& family = MetricsRegistry::instance().histogram("model_compute_duration_seconds",
+        "Time spent in each risk model's calculation", {"model"});
+    ScopedTimer timer(family.with({model}));
+    return compute();
+}
+
+} // namespace
+
+AnalysisResult FraudAnalyzer::analyze_by_ticker(const std::string& ticker, int years,
+                                                const ProgressCallback& progress) {
     LOG_INFO("Analyzing ticker: {} for {} years", ticker, years);
     
     AnalysisResult result;
     result.analysis_timestamp = util::get_timestamp();
     
     if (!fetcher_) {
-        last_error_ = "No SEC fetcher configured";
+        result.error = "No SEC fetcher configured";
         return result;
     }
     
-    auto company = fetcher_->lookup_company_by_ticker(ticker);
+    report(progress, "lookup", "Looking up " + ticker);
+    auto company = fetcher_->lookup_company_by_ticker(ticker, &result.error);
     if (!company) {
-        last_error_ = fetcher_->get_last_error();
         return result;
     }
     
     result.company = *company;
     
-    auto financials = fetcher_->get_all_financial_data(company->cik, years);
-    return analyze_financials(financials, *company);
+    report(progress, "filings", "Retrieving filings for " + company->name);
+    auto financials = fetcher_->get_all_financial_data(company->cik, years, filing_reporter(progress));
+    return analyze_financials(financials, *company, progress);
 }
 
-AnalysisResult FraudAnalyzer::analyze_by_cik(const std::string& cik, int years) {
+AnalysisResult FraudAnalyzer::analyze_by_cik(const std::string& cik, int years,
+                                             const ProgressCallback& progress) {
     LOG_INFO("Analyzing CIK: {} for {} years", cik, years);
     
     AnalysisResult result;
     result.analysis_timestamp = util::get_timestamp();
     
     if (!fetcher_) {
-        last_error_ = "No SEC fetcher configured";
+        result.error = "No SEC fetcher configured";
         return result;
     }
     
-    auto company = fetcher_->lookup_company_by_cik(cik);
+    report(progress, "lookup", "Looking up CIK " + cik);
+    auto company = fetcher_->lookup_company_by_cik(cik, &result.error);
     if (!company) {
-        last_error_ = fetcher_->get_last_error();
         return result;
     }
     
     result.company = *company;
     
-    auto financials = fetcher_->get_all_financial_data(cik, years);
-    return analyze_financials(financials, *company);
+    report(progress, "filings", "Retrieving filings for " + company->name);
+    auto financials = fetcher_->get_all_financial_data(cik, years, filing_reporter(progress));
+    return analyze_financials(financials, *company, progress);
 }
 
-AnalysisResult FraudAnalyzer::analyze_financials(const std::vector<FinancialData>& financials, const CompanyInfo& company) {
+AnalysisResult FraudAnalyzer::analyze_financials(const std::vector<FinancialData>& financials, const CompanyInfo& company,
+                                                 const ProgressCallback& progress) {
     AnalysisResult result;
     result.company = company;
     result.filings = financials;
@@ -78,20 +112,26 @@ AnalysisResult FraudAnalyzer::analyze_financials(const std::vector<FinancialData
     result.analysis_timestamp = util::get_timestamp();
     
     if (financials.size() < 2) {
-        last_error_ = "Insufficient financial data for analysis";
+        result.error = "Insufficient financial data for analysis";
         return result;
     }
     
     // Calculate models
-    result.beneish = beneish_model_->calculate(financials[0], financials[1]);
-    result.altman = altman_model_->calculate(financials[0]);
-    result.piotroski = piotroski_model_->calculate(financials[0], financials[1]);
-    result.fraud_triangle = fraud_triangle_model_->calculate(financials);
+    constexpr size_t model_count = 5;
+    report(progress, "beneish", "Beneish M-Score", 1, model_count);
+    result.beneish = timed("beneish", [&] { return beneish_model_->calculate(financials[0], financials[1]); });
+    report(progress, "altman", "Altman Z-Score", 2, model_count);
+    result.altman = timed("altman", [&] { return altman_model_->calculate(financials[0]); });
+    report(progress, "piotroski", "Piotroski F-Score", 3, model_count);
+    result.piotroski = timed("piotroski", [&] { return piotroski_model_->calculate(financials[0], financials[1]); });
+    report(progress, "fraud_triangle", "Fraud Triangle", 4, model_count);
+    result.fraud_triangle = timed("fraud_triangle", [&] { return fraud_triangle_model_->calculate(financials); });
     
-    auto values = extract_all_values(financials);
-    result.benford = benford_model_->calculate(values);
+    report(progress, "benford", "Benford's Law", 5, model_count);
+    result.benford = timed("benford", [&] { return benford_model_->calculate(extract_all_values(financials)); });
     
     // Detect red flags
+    report(progress, "scoring", "Red flags, trends and composite score");
     result.red_flags = detect_red_flags(result);
     
     // Analyze trends
@@ -12,6 +12,72 @@
 
 namespace sec_analyzer {
 
+std::optional<CachedResponse> ResponseCache::get(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return std::nullopt;
+    
+    recency_.splice(recency_.begin(), recency_, it->second.recency);
+    const Entry& entry = it->second;
+    return CachedResponse{entry.body, entry.etag, entry.last_modified,
+                          std::chrono::steady_clock::now() < entry.expires};
+}
+
+void ResponseCache::put(const std::string& key, std::string body, std::string etag,
+                        std::string last_modified, std::chrono::seconds ttl) {
+    put(key, std::make_shared<const std::string>(std::move(body)), std::move(etag),
+        std::move(last_modified), ttl);
+}
+
+void ResponseCache::put(const std::string& key, std::shared_ptr<const std::string> body, std::string etag,
+                        std::string last_modified, std::chrono::seconds ttl) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) erase(it);
+    if (body->size() > max_bytes_ / 4) return;
+    
+    // Evict from the cold end until the new body fits
+    while (!recency_.empty() && stats_.bytes + body->size() > max_bytes_) {
+        erase(entries_.find(recency_.back()));
+        ++stats_.evictions;
+    }
+    
+    recency_.push_front(key);
+    stats_.bytes += body->size();
+    entries_[key] = Entry{std::move(body), std::move(etag),
+                          std::move(last_modified), std::chrono::steady_clock::now() + ttl,
+                          recency_.begin()};
+}
+
+void ResponseCache::refresh(const std::string& key, std::chrono::seconds ttl) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        it->second.expires = std::chrono::steady_clock::now() + ttl;
+    }
+}
+
+void ResponseCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    recency_.clear();
+    stats_.bytes = 0;
+}
+
+ResponseCacheStats ResponseCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ResponseCacheStats stats = stats_;
+    stats.entries = entries_.size();
+    return stats;
+}
+
+// Caller holds mutex_
+void ResponseCache::erase(std::unordered_map<std::string, Entry>::iterator it) {
+    stats_.bytes -= it->second.body->size();
+    recency_.erase(it->second.recency);
+    entries_.erase(it);
+}
+
 void FileCache::ensure_directory() {
     util::create_directory(cache_dir_);
 }
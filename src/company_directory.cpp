@@ -0,0 +1,344 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Company Directory Implementation
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ */
+
+#include <sec_analyzer/company_directory.h>
+#include <sec_analyzer/json.h>
+#include <sec_analyzer/logger.h>
+#include <sec_analyzer/util.h>
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <cctype>
+
+namespace sec_analyzer {
+
+namespace {
+
+struct NameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+};
+
+uint32_t trigram(std::string_view text, size_t at) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(text[at])) << 16) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(text[at + 1])) << 8) |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[at + 2]));
+}
+
+std::string upper(std::string_view text) {
+    std::string out(text);
+    for (char& c : out) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    return out;
+}
+
+// SEC writes class shares with a hyphen (BRK-B); users often type a period
+std::string ticker_key(std::string_view ticker) {
+    std::string key = upper(ticker);
+    std::replace(key.begin(), key.end(), '.', '-');
+    return key;
+}
+
+} // namespace
+
+struct CompanyDirectory::Snapshot {
+    struct Entry {
+        CompanyInfo info;
+        std::string name_upper;
+        std::string ticker_upper;
+    };
+
+    std::vector<Entry> entries;     // In SEC's listing order
+    std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> by_ticker;
+    std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> by_cik;
+
+    // Trigram -> [offset, offset + count) of postings, each run ascending by entry
+    std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> trigrams;
+    std::vector<uint32_t> postings;
+
+    // Words of every name plus every ticker, sorted; views into entries
+    std::vector<std::pair<std::string_view, uint32_t>> prefixes;
+
+    std::chrono::steady_clock::time_point loaded_at;
+
+    // Fields a substring query is matched against
+    enum Field : unsigned { NAME = 1, TICKER = 2 };
+
+    void build_indexes();
+    std::vector<uint32_t> substring_matches(std::string_view query, unsigned fields, size_t limit) const;
+    std::vector<uint32_t> prefix_matches(std::string_view query, size_t limit) const;
+};
+
+void CompanyDirectory::Snapshot::build_indexes() {
+    std::vector<uint64_t> pairs;   // trigram << 32 | entry
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        const Entry& entry = entries[i];
+        by_ticker.try_emplace(entry.ticker_upper, i);
+        by_cik.try_emplace(entry.info.cik, i);
+
+        for (std::string_view text : {std::string_view(entry.name_upper), std::string_view(entry.ticker_upper)}) {
+            for (size_t at = 0; at + 3 <= text.size(); ++at) {
+                pairs.push_back(static_cast<uint64_t>(trigram(text, at)) << 32 | i);
+            }
+        }
+
+        prefixes.emplace_back(entry.ticker_upper, i);
+        std::string_view name = entry.name_upper;
+        size_t at = 0;
+        while (at < name.size()) {
+            while (at < name.size() && !std::isalnum(static_cast<unsigned char>(name[at]))) ++at;
+            size_t end = at;
+            while (end < name.size() && std::isalnum(static_cast<unsigned char>(name[end]))) ++end;
+            if (end > at) prefixes.emplace_back(name.substr(at, end - at), i);
+            at = end;
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    postings.reserve(pairs.size());
+    for (uint64_t pair : pairs) {
+        uint32_t gram = static_cast<uint32_t>(pair >> 32);
+        auto [it, inserted] = trigrams.try_emplace(gram, static_cast<uint32_t>(postings.size()), 0);
+        ++it->second.second;
+        postings.push_back(static_cast<uint32_t>(pair));
+    }
+
+    std::sort(prefixes.begin(), prefixes.end());
+}
+
+std::vector<uint32_t> CompanyDirectory::Snapshot::substring_matches(std::string_view query, unsigned fields,
+                                                                    size_t limit) const {
+    // Every trigram of the query must occur; walk the rarest one's postings
+    std::vector<std::pair<const uint32_t*, const uint32_t*>> lists;
+    for (size_t at = 0; at + 3 <= query.size(); ++at) {
+        auto it = trigrams.find(trigram(query, at));
+        if (it == trigrams.end()) return {};
+        const uint32_t* begin = postings.data() + it->second.first;
+        lists.emplace_back(begin, begin + it->second.second);
+    }
+    std::sort(lists.begin(), lists.end(), [](const auto& a, const auto& b) {
+        return (a.second - a.first) < (b.second - b.first);
+    });
+
+    std::vector<uint32_t> matches;
+    for (const uint32_t* candidate = lists[0].first; candidate != lists[0].second; ++candidate) {
+        bool in_all = std::all_of(lists.begin() + 1, lists.end(), [&](const auto& list) {
+            return std::binary_search(list.first, list.second, *candidate);
+        });
+        if (!in_all) continue;
+
+        // Trigrams can all occur without the query occurring; confirm it
+        const Entry& entry = entries[*candidate];
+        bool found = ((fields & NAME) && entry.name_upper.find(query) != std::string::npos) ||
+                     ((fields & TICKER) && entry.ticker_upper.find(query) != std::string::npos);
+        if (!found) continue;
+
+        matches.push_back(*candidate);
+        if (matches.size() >= limit) break;
+    }
+    return matches;
+}
+
+std::vector<uint32_t> CompanyDirectory::Snapshot::prefix_matches(std::string_view query, size_t limit) const {
+    std::vector<uint32_t> matches;
+    auto it = std::lower_bound(prefixes.begin(), prefixes.end(), query,
+                               [](const auto& prefix, std::string_view q) { return prefix.first < q; });
+    for (; it != prefixes.end() && it->first.substr(0, query.size()) == query; ++it) {
+        matches.push_back(it->second);
+    }
+    std::sort(matches.begin(), matches.end());
+    matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+    if (matches.size() > limit) matches.resize(limit);
+    return matches;
+}
+
+CompanyDirectory::CompanyDirectory(Loader loader) : loader_(std::move(loader)) {}
+
+CompanyDirectory::~CompanyDirectory() {
+    stop();
+}
+
+void CompanyDirectory::start(std::chrono::seconds interval) {
+    if (running_.exchange(true)) return;
+    refresher_ = std::thread(&CompanyDirectory::refresh_loop, this, interval);
+}
+
+void CompanyDirectory::stop() {
+    {
+        std::lock_guard<std::mutex> lock(refresher_mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    refresher_cv_.notify_all();
+    if (refresher_.joinable()) {
+        refresher_.join();
+    }
+}
+
+bool CompanyDirectory::load(const JsonValue& document) {
+    if (!document.is_object()) {
+        LOG_ERROR("Company tickers document is not a JSON object");
+        return false;
+    }
+
+    // Keys are "0", "1", ... in SEC's listing order, which the object's sorted keys lose
+    std::vector<std::pair<uint32_t, const JsonValue*>> rows;
+    for (const auto& [key, value] : document.as_object()) {
+        uint32_t rank = 0;
+        std::from_chars(key.data(), key.data() + key.size(), rank);
+        if (value.is_object()) rows.emplace_back(rank, &value);
+    }
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->entries.reserve(rows.size());
+    for (const auto& [rank, value] : rows) {
+        if (!value->contains("ticker") || !value->contains("cik_str")) continue;
+        const JsonValue& ticker = value->at("ticker");
+        const JsonValue& cik = value->at("cik_str");
+        if (!ticker.is_string() || !(cik.is_number() || cik.is_string())) continue;
+
+        Snapshot::Entry entry;
+        entry.info.ticker = ticker.as_string();
+        entry.info.name = value->contains("title") && value->at("title").is_string()
+            ? value->at("title").as_string() : "";
+        entry.info.cik = util::normalize_cik(cik.is_number() ? std::to_string(cik.as_int()) : cik.as_string());
+        entry.name_upper = upper(entry.info.name);
+        entry.ticker_upper = ticker_key(entry.info.ticker);
+        snapshot->entries.push_back(std::move(entry));
+    }
+    snapshot->build_indexes();
+    snapshot->loaded_at = std::chrono::steady_clock::now();
+
+    LOG_INFO("Company directory loaded: {} tickers, {} companies", snapshot->entries.size(),
+             snapshot->by_cik.size());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshot_ = std::move(snapshot);
+    return true;
+}
+
+bool CompanyDirectory::refresh(std::string* error) {
+    std::string reason;
+    std::optional<JsonValue> document = loader_(reason);
+    if (document) {
+        if (load(*document)) {
+            refreshes_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        reason = "Invalid company tickers document";
+    }
+    failures_.fetch_add(1, std::memory_order_relaxed);
+    LOG_WARNING("Company directory refresh failed: {}{}", reason, loaded() ? "; keeping the previous copy" : "");
+    if (error) *error = reason;
+    return false;
+}
+
+bool CompanyDirectory::ensure_loaded(std::string* error) {
+    if (loaded()) return true;
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    // Whoever held the lock may have just loaded it
+    if (loaded()) return true;
+    return refresh(error);
+}
+
+void CompanyDirectory::refresh_loop(std::chrono::seconds interval) {
+    bool ok = false;
+    {
+        std::lock_guard<std::mutex> lock(load_mutex_);
+        ok = loaded() || refresh();
+    }
+    while (running_) {
+        auto wait = ok ? interval : std::min<std::chrono::seconds>(interval, RETRY_INTERVAL);
+        {
+            std::unique_lock<std::mutex> lock(refresher_mutex_);
+            refresher_cv_.wait_for(lock, wait, [this]() { return !running_; });
+        }
+        if (!running_) break;
+
+        std::lock_guard<std::mutex> lock(load_mutex_);
+        ok = refresh();
+    }
+}
+
+std::shared_ptr<const CompanyDirectory::Snapshot> CompanyDirectory::current() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return snapshot_;
+}
+
+bool CompanyDirectory::loaded() const {
+    return current() != nullptr;
+}
+
+std::optional<CompanyInfo> CompanyDirectory::find_ticker(std::string_view ticker) const {
+    auto snapshot = current();
+    if (!snapshot) return std::nullopt;
+    auto it = snapshot->by_ticker.find(std::string_view(ticker_key(ticker)));
+    if (it == snapshot->by_ticker.end()) return std::nullopt;
+    return snapshot->entries[it->second].info;
+}
+
+std::optional<CompanyInfo> CompanyDirectory::find_cik(const std::string& cik) const {
+    auto snapshot = current();
+    if (!snapshot) return std::nullopt;
+    auto it = snapshot->by_cik.find(std::string_view(util::normalize_cik(cik)));
+    if (it == snapshot->by_cik.end()) return std::nullopt;
+    return snapshot->entries[it->second].info;
+}
+
+std::vector<CompanyInfo> CompanyDirectory::search(std::string_view query, size_t limit) const {
+    std::vector<CompanyInfo> results;
+    auto snapshot = current();
+    // Names are matched as typed; tickers in their stored form, so BRK. finds BRK-B
+    std::string key = upper(query);
+    std::string ticker = ticker_key(query);
+    if (!snapshot || key.empty() || limit == 0) return results;
+
+    std::optional<uint32_t> exact;
+    auto it = snapshot->by_ticker.find(std::string_view(ticker));
+    if (it != snapshot->by_ticker.end()) {
+        exact = it->second;
+        results.push_back(snapshot->entries[it->second].info);
+    }
+
+    // One extra in case the exact match turns up again among the rest.
+    // Name words hold no '.' or '-', so short queries only need the ticker form.
+    std::vector<uint32_t> matches;
+    if (key.size() < 3) {
+        matches = snapshot->prefix_matches(ticker, limit + 1);
+    } else if (key == ticker) {
+        matches = snapshot->substring_matches(key, Snapshot::NAME | Snapshot::TICKER, limit + 1);
+    } else {
+        auto by_name = snapshot->substring_matches(key, Snapshot::NAME, limit + 1);
+        auto by_ticker = snapshot->substring_matches(ticker, Snapshot::TICKER, limit + 1);
+        std::set_union(by_name.begin(), by_name.end(), by_ticker.begin(), by_ticker.end(),
+                       std::back_inserter(matches));
+        if (matches.size() > limit + 1) matches.resize(limit + 1);
+    }
+    for (uint32_t index : matches) {
+        if (results.size() >= limit) break;
+        if (exact && index == *exact) continue;
+        results.push_back(snapshot->entries[index].info);
+    }
+    return results;
+}
+
+CompanyDirectoryStats CompanyDirectory::stats() const {
+    CompanyDirectoryStats stats;
+    stats.refreshes = refreshes_.load(std::memory_order_relaxed);
+    stats.failures = failures_.load(std::memory_order_relaxed);
+    if (auto snapshot = current()) {
+        stats.companies = snapshot->entries.size();
+        stats.age_seconds = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - snapshot->loaded_at).count();
+    }
+    return stats;
+}
+
+} // namespace sec_analyzer
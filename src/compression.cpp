@@ -0,0 +1,164 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Compression Helpers Implementation
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ */
+
+#include <sec_analyzer/compression.h>
+#include <sec_analyzer/util.h>
+
+#include <algorithm>
+
+#ifdef SEC_ANALYZER_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+namespace sec_analyzer {
+namespace compression {
+
+namespace {
+
+#ifdef SEC_ANALYZER_HAS_ZLIB
+// window_bits selects the container: 15 + 16 = gzip, 15 = zlib (deflate)
+bool deflate_with(std::string_view input, std::string& output, int level, int window_bits) {
+    z_stream stream{};
+    if (deflateInit2(&stream, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+
+    output.resize(deflateBound(&stream, static_cast<uLong>(input.size())));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    int result = ::deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+    return result == Z_STREAM_END;
+}
+
+// 15 + 32 auto-detects a gzip or zlib header
+bool inflate_with(std::string_view input, std::string& output, size_t max_output) {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+        return false;
+    }
+
+    output.clear();
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    int result = Z_OK;
+    while (result == Z_OK) {
+        size_t used = output.size();
+        if (used >= max_output) break;
+        output.resize(std::min(max_output, std::max<size_t>(used * 2, input.size() * 4 + 4096)));
+        stream.next_out = reinterpret_cast<Bytef*>(output.data() + used);
+        stream.avail_out = static_cast<uInt>(output.size() - used);
+        result = ::inflate(&stream, Z_NO_FLUSH);
+        output.resize(output.size() - stream.avail_out);
+    }
+    inflateEnd(&stream);
+    return result == Z_STREAM_END;
+}
+#endif
+
+} // namespace
+
+bool available() {
+#ifdef SEC_ANALYZER_HAS_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool gzip(std::string_view input, std::string& output, int level) {
+#ifdef SEC_ANALYZER_HAS_ZLIB
+    return deflate_with(input, output, level, 15 + 16);
+#else
+    (void)input;
+    (void)output;
+    (void)level;
+    return false;
+#endif
+}
+
+bool deflate(std::string_view input, std::string& output, int level) {
+#ifdef SEC_ANALYZER_HAS_ZLIB
+    return deflate_with(input, output, level, 15);
+#else
+    (void)input;
+    (void)output;
+    (void)level;
+    return false;
+#endif
+}
+
+bool encode(std::string_view coding, std::string_view input, std::string& output, int level) {
+    if (coding == "gzip") return gzip(input, output, level);
+    if (coding == "deflate") return deflate(input, output, level);
+    return false;
+}
+
+bool decode(std::string_view coding, std::string_view input, std::string& output, size_t max_output) {
+#ifdef SEC_ANALYZER_HAS_ZLIB
+    if (coding != "gzip" && coding != "deflate") return false;
+    return inflate_with(input, output, max_output);
+#else
+    (void)coding;
+    (void)input;
+    (void)output;
+    (void)max_output;
+    return false;
+#endif
+}
+
+bool is_compressible(std::string_view content_type) {
+    if (content_type.substr(0, 5) == "text/") return true;
+    return content_type.find("json") != std::string_view::npos ||
+           content_type.find("javascript") != std::string_view::npos ||
+           content_type.find("xml") != std::string_view::npos;
+}
+
+bool accepts(std::string_view accept_encoding, std::string_view coding) {
+    bool wildcard = false;
+    while (!accept_encoding.empty()) {
+        size_t comma = accept_encoding.find(',');
+        std::string_view item = accept_encoding.substr(0, comma);
+        accept_encoding.remove_prefix(comma == std::string_view::npos ? accept_encoding.size() : comma + 1);
+
+        size_t semi = item.find(';');
+        std::string_view name = item.substr(0, semi);
+        while (!name.empty() && name.front() == ' ') name.remove_prefix(1);
+        while (!name.empty() && name.back() == ' ') name.remove_suffix(1);
+
+        // "q=0" (optionally "0.000") means explicitly not acceptable
+        bool refused = false;
+        if (semi != std::string_view::npos) {
+            std::string_view params = item.substr(semi + 1);
+            size_t q = params.find("q=");
+            if (q != std::string_view::npos) {
+                std::string_view value = params.substr(q + 2);
+                value = value.substr(0, value.find_first_of("; "));
+                refused = !value.empty() && value[0] == '0' &&
+                          value.find_first_of("123456789") == std::string_view::npos;
+            }
+        }
+
+        if (util::iequals(name, coding)) return !refused;
+        if (name == "*") wildcard = !refused;
+    }
+    return wildcard;
+}
+
+std::string_view negotiate(std::string_view accept_encoding) {
+    if (!available() || accept_encoding.empty()) return {};
+    // gzip first: identical ratio, and older clients disagree on raw vs zlib deflate
+    if (accepts(accept_encoding, "gzip")) return "gzip";
+    if (accepts(accept_encoding, "deflate")) return "deflate";
+    return {};
+}
+
+} // namespace compression
+} // namespace sec_analyzer
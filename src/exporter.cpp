@@ -148,6 +148,9 @@ std::string ResultExporter::to_csv(const AnalysisResult& result) {
     oss << "Ticker," << result.company.ticker << "\n";
     oss << "CIK," << result.company.cik << "\n";
     oss << "Filings Analyzed," << result.filings_analyzed << "\n";
+    if (!result.error.empty()) {
+        oss << "Error," << escape_json(result.error) << "\n";
+    }
     
     // Risk
     oss << "Risk Score," << std::fixed << std::setprecision(4) << result.composite_risk_score << "\n";
@@ -195,6 +198,12 @@ std::string ResultExporter::filings_to_csv(const std::vector<FinancialData>& fil
 }
 
 std::string ResultExporter::to_html(const AnalysisResult& result) {
+    return html_document_start("Fraud Analysis Report - " + result.company.ticker) +
+           html_report_section(result) +
+           html_document_end(result.version);
+}
+
+std::string ResultExporter::html_document_start(const std::string& title) {
     std::ostringstream oss;
     
     oss << R"(<!DOCTYPE html>
@@ -202,11 +211,12 @@ std::string ResultExporter::to_html(const AnalysisResult& result) {
 <head>
     <meta charset="UTF-8">
     <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Fraud Analysis Report - )" << escape_html(result.company.ticker) << R"(</title>
+    <title>)" << escape_html(title) << R"(</title>
     <style>
         body { font-family: -apple-system, BlinkMacSystemFont, 'Segoe UI', Roboto, sans-serif; 
                max-width: 900px; margin: 0 auto; padding: 20px; background: #f5f5f5; }
         .report { background: white; padding: 30px; border-radius: 8px; box-shadow: 0 2px 8px rgba(0,0,0,0.1); }
+        .report + .report { margin-top: 30px; }
         h1 { color: #1f2937; border-bottom: 2px solid #2563eb; padding-bottom: 10px; }
         h2 { color: #374151; margin-top: 30px; }
         .meta { color: #6b7280; font-size: 14px; margin-bottom: 20px; }
@@ -228,13 +238,27 @@ std::string ResultExporter::to_html(const AnalysisResult& result) {
     </style>
 </head>
 <body>
-    <div class="report">
+)";
+    
+    return oss.str();
+}
+
+std::string ResultExporter::html_report_section(const AnalysisResult& result) {
+    std::ostringstream oss;
+    
+    oss << R"(    <div class="report">
         <h1>SEC EDGAR Fraud Analysis Report</h1>
         <div class="meta">
             <p><strong>Company:</strong> )" << escape_html(result.company.name) << R"(</p>
             <p><strong>Ticker:</strong> )" << result.company.ticker << R"( | <strong>CIK:</strong> )" << result.company.cik << R"(</p>
             <p><strong>Generated:</strong> )" << result.analysis_timestamp << R"(</p>
         </div>
+        )";
+    if (!result.error.empty()) {
+        oss << R"(<p class="error"><strong>Analysis failed:</strong> )" << escape_html(result.error) << R"(</p>
+        )";
+    }
+    oss << R"(
         
         <h2>Risk Summary</h2>
         <div class="score-card">
@@ -285,12 +309,19 @@ std::string ResultExporter::to_html(const AnalysisResult& result) {
     oss << R"(
         <h2>Recommendation</h2>
         <p>)" << escape_html(result.recommendation) << R"(</p>
-        
-        <footer>
-            <p>SEC EDGAR Fraud Analyzer v)" << result.version << R"(</p>
-            <p>Author: Bennie Shearer (Retired) | For educational and research purposes</p>
-        </footer>
     </div>
+)";
+    
+    return oss.str();
+}
+
+std::string ResultExporter::html_document_end(const std::string& version) {
+    std::ostringstream oss;
+    
+    oss << R"(    <footer>
+        <p>SEC EDGAR Fraud Analyzer v)" << version << R"(</p>
+        <p>Author: Bennie Shearer (Retired) | For educational and research purposes</p>
+    </footer>
 </body>
 </html>)";
     
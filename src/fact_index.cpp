@@ -0,0 +1,146 @@
+/**
+ * SEC EDGAR Fraud Analyzer - XBRL Fact Index Implementation
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ */
+
+#include <sec_analyzer/fact_index.h>
+#include <sec_analyzer/json.h>
+
+#include <array>
+
+namespace sec_analyzer {
+
+namespace {
+
+constexpr std::array<FactUnit, 3> UNIT_ORDER = {FactUnit::USD, FactUnit::PURE, FactUnit::SHARES};
+constexpr std::array<const char*, 3> UNIT_NAMES = {"USD", "pure", "shares"};
+
+constexpr std::array<FiscalPeriod, 5> ALL_PERIODS = {
+    FiscalPeriod::FY, FiscalPeriod::Q1, FiscalPeriod::Q2, FiscalPeriod::Q3, FiscalPeriod::OTHER
+};
+
+FiscalPeriod period_of(const std::string& fp) {
+    if (fp.size() != 2) return FiscalPeriod::OTHER;
+    if (fp == "FY") return FiscalPeriod::FY;
+    if (fp == "Q1") return FiscalPeriod::Q1;
+    if (fp == "Q2") return FiscalPeriod::Q2;
+    if (fp == "Q3") return FiscalPeriod::Q3;
+    return FiscalPeriod::OTHER;
+}
+
+FactForm form_of(const std::string& form) {
+    if (form == "10-K") return FactForm::K10;
+    if (form == "10-Q") return FactForm::Q10;
+    return FactForm::OTHER;
+}
+
+} // namespace
+
+FactIndex::FactIndex(const JsonValue& facts, std::span<const std::string_view> concepts) {
+    if (!facts.contains("us-gaap") || !facts.at("us-gaap").is_object()) return;
+    const JsonObject& us_gaap = facts.at("us-gaap").as_object();
+
+    if (concepts.empty()) {
+        for (const auto& [name, concept_data] : us_gaap) {
+            add_concept(name, concept_data);
+        }
+        return;
+    }
+    for (std::string_view name : concepts) {
+        auto it = us_gaap.find(std::string(name));
+        if (it != us_gaap.end()) add_concept(it->first, it->second);
+    }
+}
+
+void FactIndex::add_concept(const std::string& name, const JsonValue& concept_data) {
+    if (!concept_data.contains("units") || concepts_.count(name)) return;
+    const auto& units = concept_data.at("units");
+    uint32_t concept_id = static_cast<uint32_t>(concepts_.size());
+
+    bool indexed = false;
+    for (size_t u = 0; u < UNIT_ORDER.size(); ++u) {
+        if (!units.contains(UNIT_NAMES[u]) || !units.at(UNIT_NAMES[u]).is_array()) continue;
+        const auto& values = units.at(UNIT_NAMES[u]).as_array();
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (!values[i].is_object()) continue;
+
+            // One walk over the entry's fields rather than a lookup per field
+            const JsonValue* fy = nullptr;
+            const JsonValue* val = nullptr;
+            FiscalPeriod period = FiscalPeriod::OTHER;
+            FactForm form = FactForm::OTHER;
+            for (const auto& [field, value] : values[i].as_object()) {
+                if (field == "fy") fy = &value;
+                else if (field == "val") val = &value;
+                else if (field == "fp" && value.is_string()) period = period_of(value.as_string());
+                else if (field == "form" && value.is_string()) form = form_of(value.as_string());
+            }
+            if (!fy || !val || !fy->is_number() || !val->is_number()) continue;
+
+            // The first value under a key is the one a document-order scan would find
+            facts_.try_emplace(key(concept_id, UNIT_ORDER[u], fy->as_int(), period, form),
+                               Fact{val->as_number(), static_cast<uint32_t>(i)});
+            indexed = true;
+        }
+    }
+    if (indexed) concepts_.emplace(name, concept_id);
+}
+
+uint64_t FactIndex::key(uint32_t concept_id, FactUnit unit, int fiscal_year, FiscalPeriod period, FactForm form) {
+    // concept:32 | year:24 | unit:2 | period:3 | form:2
+    return (static_cast<uint64_t>(concept_id) << 32) |
+           (static_cast<uint64_t>(static_cast<uint32_t>(fiscal_year) & 0xFFFFFF) << 8) |
+           (static_cast<uint64_t>(unit) << 5) |
+           (static_cast<uint64_t>(period) << 2) |
+           static_cast<uint64_t>(form);
+}
+
+const FactIndex::Fact* FactIndex::probe(uint32_t concept_id, FactUnit unit, int fiscal_year,
+                                        FiscalPeriod period, FactForm form) const {
+    auto it = facts_.find(key(concept_id, unit, fiscal_year, period, form));
+    return it != facts_.end() ? &it->second : nullptr;
+}
+
+std::optional<double> FactIndex::find(std::string_view concept_name, FactUnit unit, int fiscal_year,
+                                      FiscalPeriod period, FactForm form) const {
+    auto it = concepts_.find(concept_name);
+    if (it == concepts_.end()) return std::nullopt;
+    const Fact* fact = probe(it->second, unit, fiscal_year, period, form);
+    if (!fact) return std::nullopt;
+    return fact->value;
+}
+
+double FactIndex::value(std::string_view concept_name, int fiscal_year, bool annual) const {
+    auto it = concepts_.find(concept_name);
+    if (it == concepts_.end()) return 0.0;
+    uint32_t concept_id = it->second;
+
+    for (FactUnit unit : UNIT_ORDER) {
+        // A query spans several keys; the earliest matching entry wins, as in a document-order scan
+        const Fact* best = nullptr;
+        auto consider = [&](FiscalPeriod period, FactForm form) {
+            const Fact* fact = probe(concept_id, unit, fiscal_year, period, form);
+            if (fact && (!best || fact->position < best->position)) best = fact;
+        };
+
+        FactForm form = annual ? FactForm::K10 : FactForm::Q10;
+        for (FiscalPeriod period : ALL_PERIODS) {
+            consider(period, form);
+        }
+        for (FactForm other : {FactForm::K10, FactForm::Q10, FactForm::OTHER}) {
+            if (other == form) continue;
+            if (annual) {
+                consider(FiscalPeriod::FY, other);
+            } else {
+                consider(FiscalPeriod::Q1, other);
+                consider(FiscalPeriod::Q2, other);
+                consider(FiscalPeriod::Q3, other);
+            }
+        }
+        if (best) return best->value;
+    }
+    return 0.0;
+}
+
+} // namespace sec_analyzer
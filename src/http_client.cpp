@@ -0,0 +1,694 @@
+/**
+ * SEC EDGAR Fraud Analyzer - HTTP Client Implementation
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ */
+
+#include <sec_analyzer/http_client.h>
+#include <sec_analyzer/compression.h>
+#include <sec_analyzer/logger.h>
+
+#ifndef _WIN32
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <cerrno>
+#include <cstring>
+#include <cstdio>
+
+#ifdef SEC_ANALYZER_HAS_OPENSSL
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <openssl/x509v3.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+
+namespace sec_analyzer {
+
+namespace {
+
+constexpr size_t READ_CHUNK = 64 * 1024;
+constexpr size_t MAX_HEAD_SIZE = 64 * 1024;
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+std::string lower(std::string_view text) {
+    std::string out(text);
+    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return std::tolower(c); });
+    return out;
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+    return text;
+}
+
+bool has_token(std::string_view value, std::string_view token) {
+    return lower(value).find(token) != std::string::npos;
+}
+
+bool is_redirect(int status) {
+    return status == 301 || status == 302 || status == 303 || status == 307 || status == 308;
+}
+
+// Single-quoted for /bin/sh: ' becomes '\''
+std::string shell_quote(std::string_view text) {
+    std::string out = "'";
+    for (char c : text) {
+        if (c == '\'') out.append("'\\''");
+        else out.push_back(c);
+    }
+    out.push_back('\'');
+    return out;
+}
+
+#ifdef SEC_ANALYZER_HAS_OPENSSL
+std::string tls_error() {
+    unsigned long code = ERR_get_error();
+    if (code == 0) return std::strerror(errno);
+    char text[256];
+    ERR_error_string_n(code, text, sizeof(text));
+    return text;
+}
+#endif
+
+} // namespace
+
+struct HttpClient::Url {
+    bool https = false;
+    std::string host;
+    int port = 80;
+    std::string target = "/";       // Path and query
+
+    std::string origin() const {
+        return (https ? "https://" : "http://") + host + ":" + std::to_string(port);
+    }
+
+    std::string host_header() const {
+        std::string out = host.find(':') != std::string::npos ? "[" + host + "]" : host;
+        if (port != (https ? 443 : 80)) out += ":" + std::to_string(port);
+        return out;
+    }
+
+    // scheme://host[:port][/target]; IPv6 hosts in brackets
+    static bool parse(std::string_view url, Url& out) {
+        if (url.substr(0, 8) == "https://") {
+            out.https = true;
+            out.port = 443;
+            url.remove_prefix(8);
+        } else if (url.substr(0, 7) == "http://") {
+            out.https = false;
+            out.port = 80;
+            url.remove_prefix(7);
+        } else {
+            return false;
+        }
+
+        size_t slash = url.find_first_of("/?#");
+        std::string_view authority = url.substr(0, slash);
+        std::string_view target = slash == std::string_view::npos ? std::string_view() : url.substr(slash);
+        target = target.substr(0, target.find('#'));
+        out.target = target.empty() || target.front() != '/' ? "/" + std::string(target) : std::string(target);
+
+        std::string_view port;
+        if (!authority.empty() && authority.front() == '[') {
+            size_t close = authority.find(']');
+            if (close == std::string_view::npos) return false;
+            out.host = std::string(authority.substr(1, close - 1));
+            std::string_view rest = authority.substr(close + 1);
+            if (!rest.empty()) {
+                if (rest.front() != ':') return false;
+                port = rest.substr(1);
+            }
+        } else {
+            size_t colon = authority.find(':');
+            out.host = std::string(authority.substr(0, colon));
+            if (colon != std::string_view::npos) port = authority.substr(colon + 1);
+        }
+        if (!port.empty()) {
+            auto result = std::from_chars(port.data(), port.data() + port.size(), out.port);
+            if (result.ec != std::errc() || result.ptr != port.data() + port.size() ||
+                out.port <= 0 || out.port > 65535) {
+                return false;
+            }
+        }
+        return !out.host.empty();
+    }
+};
+
+struct HttpClient::Connection {
+    int fd = -1;
+#ifdef SEC_ANALYZER_HAS_OPENSSL
+    SSL* ssl = nullptr;
+#endif
+    std::string buffer;             // Received and not yet consumed
+    std::string error;              // Why the last read or write failed
+    std::chrono::steady_clock::time_point last_used;
+
+    ~Connection() {
+#ifdef SEC_ANALYZER_HAS_OPENSSL
+        if (ssl) {
+            SSL_shutdown(ssl);
+            SSL_free(ssl);
+        }
+#endif
+        if (fd >= 0) ::close(fd);
+    }
+
+    bool write_all(std::string_view data) {
+        while (!data.empty()) {
+            ssize_t n;
+#ifdef SEC_ANALYZER_HAS_OPENSSL
+            if (ssl) {
+                n = SSL_write(ssl, data.data(), static_cast<int>(data.size()));
+                if (n <= 0) {
+                    error = "TLS write failed: " + tls_error();
+                    return false;
+                }
+            } else
+#endif
+            {
+                n = ::send(fd, data.data(), data.size(), SEND_FLAGS);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) {
+                    error = errno == EAGAIN || errno == EWOULDBLOCK ? "Timed out sending request"
+                                                                    : std::string(std::strerror(errno));
+                    return false;
+                }
+            }
+            data.remove_prefix(static_cast<size_t>(n));
+        }
+        return true;
+    }
+
+    // Append up to READ_CHUNK bytes to buffer; false on close, timeout or error
+    bool fill() {
+        size_t used = buffer.size();
+        buffer.resize(used + READ_CHUNK);
+#ifdef TCP_QUICKACK
+        // Quick ACK mode lapses on its own. Re-arm it so a server that sent the
+        // head and body as separate writes (Nagle) doesn't wait on a delayed ACK.
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_QUICKACK, &one, sizeof(one));
+#endif
+        ssize_t n;
+        for (;;) {
+#ifdef SEC_ANALYZER_HAS_OPENSSL
+            if (ssl) {
+                n = SSL_read(ssl, buffer.data() + used, static_cast<int>(READ_CHUNK));
+                if (n <= 0) {
+                    int reason = SSL_get_error(ssl, static_cast<int>(n));
+                    bool syscall = reason == SSL_ERROR_SYSCALL;
+                    if (reason == SSL_ERROR_ZERO_RETURN || (syscall && errno == 0)) {
+                        error = "Connection closed";
+                    } else if (reason == SSL_ERROR_WANT_READ || reason == SSL_ERROR_WANT_WRITE ||
+                               (syscall && (errno == EAGAIN || errno == EWOULDBLOCK))) {
+                        error = "Timed out waiting for response";
+                    } else {
+                        error = "TLS read failed: " + tls_error();
+                    }
+                    n = 0;
+                }
+                break;
+            }
+#endif
+            n = ::recv(fd, buffer.data() + used, READ_CHUNK, 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n == 0) {
+                error = "Connection closed";
+            } else if (n < 0) {
+                error = errno == EAGAIN || errno == EWOULDBLOCK ? "Timed out waiting for response"
+                                                                : std::string(std::strerror(errno));
+                n = 0;
+            }
+            break;
+        }
+        buffer.resize(used + static_cast<size_t>(n));
+        return n > 0;
+    }
+
+    // An idle connection is usable if the server has neither closed it nor sent anything
+    bool alive() const {
+#ifdef SEC_ANALYZER_HAS_OPENSSL
+        if (ssl && SSL_pending(ssl) > 0) return false;
+#endif
+        pollfd pfd{fd, POLLIN, 0};
+        return ::poll(&pfd, 1, 0) == 0;
+    }
+};
+
+HttpClient::HttpClient() {
+#ifdef SEC_ANALYZER_HAS_OPENSSL
+    SSL_CTX* context = SSL_CTX_new(TLS_client_method());
+    if (context) {
+        SSL_CTX_set_min_proto_version(context, TLS1_2_VERSION);
+        SSL_CTX_set_verify(context, SSL_VERIFY_PEER, nullptr);
+        if (SSL_CTX_set_default_verify_paths(context) != 1) {
+            LOG_WARNING("No default CA certificates found; HTTPS requests will fail verification");
+        }
+    } else {
+        LOG_ERROR("Failed to create TLS context: {}", tls_error());
+    }
+    tls_context_ = context;
+#endif
+}
+
+HttpClient::~HttpClient() {
+    idle_.clear();
+#ifdef SEC_ANALYZER_HAS_OPENSSL
+    SSL_CTX_free(static_cast<SSL_CTX*>(tls_context_));
+#endif
+}
+
+bool HttpClient::tls_available() {
+#ifdef SEC_ANALYZER_HAS_OPENSSL
+    return true;
+#else
+    return false;
+#endif
+}
+
+void HttpClient::set_base_url(const std::string& base_url) {
+    Url parsed;
+    if (!base_url.empty() && !Url::parse(base_url, parsed)) {
+        LOG_WARNING("Ignoring invalid base URL: {}", base_url);
+        return;
+    }
+    base_url_ = base_url;
+}
+
+HttpClientResponse HttpClient::get(const std::string& url, const HttpHeaderList& headers, const BodySink& sink) {
+    requests_.fetch_add(1, std::memory_order_relaxed);
+
+    Url target;
+    if (!Url::parse(url, target)) {
+        HttpClientResponse response;
+        response.error = "Invalid URL: " + url;
+        return response;
+    }
+
+    bool rebase = !base_url_.empty();
+    for (int hop = 0;; ++hop) {
+        if (rebase) {
+            Url base;
+            Url::parse(base_url_, base);
+            base.target = (base.target == "/" ? "" : base.target) + target.target;
+            target = std::move(base);
+            rebase = false;
+        }
+
+        HttpClientResponse response = target.https && !tls_available() ? curl_get(target, headers, sink)
+                                                                       : send(target, headers, sink);
+        std::string location = response.header("location");
+        if (!response.error.empty() || !is_redirect(response.status) || location.empty() || hop == MAX_REDIRECTS) {
+            return response;
+        }
+
+        LOG_DEBUG("HTTP {} redirect to {}", response.status, location);
+        Url next;
+        if (location.front() == '/') {
+            target.target = location.substr(0, location.find('#'));
+        } else if (Url::parse(location, next)) {
+            target = std::move(next);
+            rebase = !base_url_.empty();
+        } else {
+            // Relative to the current path's directory
+            std::string base = target.target.substr(0, target.target.find('?'));
+            target.target = base.substr(0, base.rfind('/') + 1) + location.substr(0, location.find('#'));
+        }
+    }
+}
+
+HttpClientResponse HttpClient::send(const Url& url, const HttpHeaderList& headers, const BodySink& sink) {
+    std::string request = "GET " + url.target + " HTTP/1.1\r\nHost: " + url.host_header() + "\r\n";
+    bool has_accept = false;
+    bool has_encoding = false;
+    for (const auto& [name, value] : headers) {
+        std::string key = lower(name);
+        has_accept |= key == "accept";
+        has_encoding |= key == "accept-encoding";
+        request.append(name).append(": ").append(value).append("\r\n");
+    }
+    if (!has_accept) request.append("Accept: */*\r\n");
+    // Compressed bodies are only asked for when collected, streamed ones arrive as sent
+    if (!has_encoding && !sink && compression::available()) request.append("Accept-Encoding: gzip\r\n");
+    request.append("\r\n");
+
+    HttpClientResponse response;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        bool reused = false;
+        std::string error;
+        auto connection = acquire(url, reused, error);
+        if (!connection) {
+            response.error = error;
+            return response;
+        }
+
+        response = HttpClientResponse();
+        bool reusable = false;
+        bool received = false;
+        if (exchange(*connection, url, request, sink, response, reusable, received)) {
+            if (reusable) release(url, std::move(connection));
+            return response;
+        }
+        // The server may close a pooled connection just as we reuse it; try once more on a fresh one
+        if (!reused || received) break;
+        retries_.fetch_add(1, std::memory_order_relaxed);
+        LOG_DEBUG("Pooled connection to {} was closed, reconnecting", url.host);
+    }
+    return response;
+}
+
+bool HttpClient::exchange(Connection& connection, const Url& url, const std::string& request,
+                          const BodySink& sink, HttpClientResponse& response, bool& reusable, bool& received) {
+    auto fail = [&](std::string message) {
+        response.error = std::move(message) + " (" + url.host + ")";
+        return false;
+    };
+
+    connection.buffer.clear();
+    if (!connection.write_all(request)) return fail("Failed to send request: " + connection.error);
+
+    // Status line and headers, skipping interim 1xx responses
+    size_t head_end;
+    bool http10 = false;
+    for (;;) {
+        while ((head_end = connection.buffer.find("\r\n\r\n")) == std::string::npos) {
+            if (connection.buffer.size() > MAX_HEAD_SIZE) return fail("Response headers too large");
+            if (!connection.fill()) return fail("No complete response: " + connection.error);
+            received = true;
+        }
+
+        std::string_view head(connection.buffer.data(), head_end);
+        size_t line_end = head.find("\r\n");
+        std::string_view status_line = head.substr(0, line_end);
+        if (status_line.substr(0, 5) != "HTTP/" || status_line.size() < 12) return fail("Malformed status line");
+        http10 = status_line.substr(5, 3) == "1.0";
+        auto result = std::from_chars(status_line.data() + 9, status_line.data() + 12, response.status);
+        if (result.ec != std::errc()) return fail("Malformed status line");
+
+        response.headers.clear();
+        head.remove_prefix(line_end == std::string_view::npos ? head.size() : line_end + 2);
+        while (!head.empty()) {
+            size_t end = head.find("\r\n");
+            std::string_view line = head.substr(0, end);
+            head.remove_prefix(end == std::string_view::npos ? head.size() : end + 2);
+            size_t colon = line.find(':');
+            if (colon == std::string_view::npos) continue;
+            std::string name = lower(trim(line.substr(0, colon)));
+            std::string_view value = trim(line.substr(colon + 1));
+            auto [it, inserted] = response.headers.try_emplace(name, value);
+            if (!inserted) it->second.append(", ").append(value);
+        }
+
+        connection.buffer.erase(0, head_end + 4);
+        if (response.status >= 200 || response.status == 101) break;
+    }
+
+    bool keep_alive = http10 ? has_token(response.header("connection"), "keep-alive")
+                             : !has_token(response.header("connection"), "close");
+    bool no_body = response.status == 204 || response.status == 304 || response.status < 200;
+    bool chunked = has_token(response.header("transfer-encoding"), "chunked");
+    std::string length_header = response.header("content-length");
+    size_t length = 0;
+    bool has_length = !length_header.empty() &&
+        std::from_chars(length_header.data(), length_header.data() + length_header.size(), length).ec == std::errc();
+
+    std::string coding = lower(response.header("content-encoding"));
+    bool streaming = sink && response.status >= 200 && response.status < 300;
+    bool decode = !streaming && (coding == "gzip" || coding == "deflate");
+    size_t delivered = 0;
+    bool aborted = false;
+    auto deliver = [&](std::string_view piece) {
+        delivered += piece.size();
+        if (streaming) {
+            aborted = aborted || !sink(piece);
+            return !aborted;
+        }
+        if (delivered > max_response_size_) return false;
+        response.body.append(piece);
+        return true;
+    };
+
+    if (no_body) {
+        reusable = keep_alive;
+    } else if (chunked) {
+        for (;;) {
+            size_t line_end;
+            while ((line_end = connection.buffer.find("\r\n")) == std::string::npos) {
+                if (!connection.fill()) return fail("Truncated chunked body: " + connection.error);
+            }
+            size_t size = 0;
+            auto result = std::from_chars(connection.buffer.data(), connection.buffer.data() + line_end, size, 16);
+            if (result.ec != std::errc()) return fail("Malformed chunk size");
+            connection.buffer.erase(0, line_end + 2);
+            if (size == 0) break;
+
+            while (size > 0) {
+                if (connection.buffer.empty() && !connection.fill()) {
+                    return fail("Truncated chunked body: " + connection.error);
+                }
+                size_t take = std::min(size, connection.buffer.size());
+                if (!deliver(std::string_view(connection.buffer.data(), take))) {
+                    return fail(aborted ? "Body rejected by receiver" : "Response too large");
+                }
+                connection.buffer.erase(0, take);
+                size -= take;
+            }
+            while (connection.buffer.size() < 2) {
+                if (!connection.fill()) return fail("Truncated chunked body: " + connection.error);
+            }
+            connection.buffer.erase(0, 2);
+        }
+        // Trailer fields end with an empty line
+        for (;;) {
+            size_t line_end;
+            while ((line_end = connection.buffer.find("\r\n")) == std::string::npos) {
+                if (!connection.fill()) return fail("Truncated chunked body: " + connection.error);
+            }
+            connection.buffer.erase(0, line_end + 2);
+            if (line_end == 0) break;
+        }
+        reusable = keep_alive;
+    } else if (has_length) {
+        if (!streaming && length > max_response_size_) return fail("Response too large");
+        if (!streaming) response.body.reserve(length);
+        size_t remaining = length;
+        while (remaining > 0) {
+            if (connection.buffer.empty() && !connection.fill()) {
+                return fail("Truncated body: " + connection.error);
+            }
+            size_t take = std::min(remaining, connection.buffer.size());
+            if (!deliver(std::string_view(connection.buffer.data(), take))) {
+                return fail(aborted ? "Body rejected by receiver" : "Response too large");
+            }
+            connection.buffer.erase(0, take);
+            remaining -= take;
+        }
+        reusable = keep_alive;
+    } else {
+        // Delimited by the server closing the connection
+        for (;;) {
+            if (!connection.buffer.empty()) {
+                if (!deliver(connection.buffer)) return fail(aborted ? "Body rejected by receiver" : "Response too large");
+                connection.buffer.clear();
+            }
+            if (!connection.fill()) break;
+        }
+        reusable = false;
+    }
+
+    // Anything left over means the server is out of step with us
+    reusable = reusable && connection.buffer.empty();
+
+    if (decode) {
+        std::string decoded;
+        if (!compression::decode(coding, response.body, decoded, max_response_size_)) {
+            return fail("Failed to decode " + coding + " response body");
+        }
+        response.body = std::move(decoded);
+        response.headers.erase("content-encoding");
+    }
+    return true;
+}
+
+std::unique_ptr<HttpClient::Connection> HttpClient::acquire(const Url& url, bool& reused, std::string& error) {
+    auto now = std::chrono::steady_clock::now();
+    std::unique_ptr<Connection> stale;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        auto it = idle_.find(url.origin());
+        while (it != idle_.end() && !it->second.empty()) {
+            std::unique_ptr<Connection> connection = std::move(it->second.back());
+            it->second.pop_back();
+            if (now - connection->last_used < std::chrono::seconds(idle_timeout_seconds_) && connection->alive()) {
+                reused = true;
+                reused_.fetch_add(1, std::memory_order_relaxed);
+                return connection;
+            }
+            stale = std::move(connection);
+        }
+    }
+    stale.reset();
+
+    auto connection = connect(url, error);
+    if (connection) opened_.fetch_add(1, std::memory_order_relaxed);
+    return connection;
+}
+
+void HttpClient::release(const Url& url, std::unique_ptr<Connection> connection) {
+    connection->last_used = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    auto& pool = idle_[url.origin()];
+    if (pool.size() < max_idle_per_host_) {
+        pool.push_back(std::move(connection));
+    }
+}
+
+std::unique_ptr<HttpClient::Connection> HttpClient::connect(const Url& url, std::string& error) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    int status = getaddrinfo(url.host.c_str(), std::to_string(url.port).c_str(), &hints, &addresses);
+    if (status != 0) {
+        error = "Cannot resolve " + url.host + ": " + gai_strerror(status);
+        return nullptr;
+    }
+
+    auto connection = std::make_unique<Connection>();
+    error = "Cannot connect to " + url.host;
+    for (addrinfo* address = addresses; address; address = address->ai_next) {
+        int fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (fd < 0) continue;
+
+        // Non-blocking connect so the timeout applies to the handshake too
+        int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        int result = ::connect(fd, address->ai_addr, address->ai_addrlen);
+        if (result < 0 && errno == EINPROGRESS) {
+            pollfd pfd{fd, POLLOUT, 0};
+            int socket_error = 0;
+            socklen_t size = sizeof(socket_error);
+            if (::poll(&pfd, 1, timeout_seconds_ * 1000) == 1 &&
+                getsockopt(fd, SOL_SOCKET, SO_ERROR, &socket_error, &size) == 0 && socket_error == 0) {
+                result = 0;
+            } else {
+                errno = socket_error ? socket_error : ETIMEDOUT;
+            }
+        }
+        if (result < 0) {
+            error = "Cannot connect to " + url.host + ": " + std::strerror(errno);
+            ::close(fd);
+            continue;
+        }
+        fcntl(fd, F_SETFL, flags);
+
+        timeval timeout{timeout_seconds_, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        connection->fd = fd;
+        break;
+    }
+    freeaddrinfo(addresses);
+    if (connection->fd < 0) return nullptr;
+
+#ifdef SEC_ANALYZER_HAS_OPENSSL
+    if (url.https) {
+        if (!tls_context_) {
+            error = "TLS is unavailable";
+            return nullptr;
+        }
+        connection->ssl = SSL_new(static_cast<SSL_CTX*>(tls_context_));
+        SSL_set_fd(connection->ssl, connection->fd);
+        SSL_set_tlsext_host_name(connection->ssl, url.host.c_str());
+        SSL_set1_host(connection->ssl, url.host.c_str());
+        if (SSL_connect(connection->ssl) != 1) {
+            error = "TLS handshake with " + url.host + " failed: " + tls_error();
+            return nullptr;
+        }
+    }
+#endif
+
+    LOG_DEBUG("Opened {} connection to {}:{}", url.https ? "TLS" : "TCP", url.host, url.port);
+    error.clear();
+    return connection;
+}
+
+HttpClientResponse HttpClient::curl_get(const Url& url, const HttpHeaderList& headers, const BodySink& sink) {
+    // -s: silent, -S: show errors, -L: follow redirects; the status code is appended after the body
+    std::string command = "curl -sSL --max-time " + std::to_string(timeout_seconds_);
+    if (compression::available()) command += " --compressed";
+    for (const auto& [name, value] : headers) {
+        command += " -H " + shell_quote(name + ": " + value);
+    }
+    command += " -w '%{http_code}' " + shell_quote(url.origin() + url.target) + " 2>/dev/null";
+
+    HttpClientResponse response;
+    FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe) {
+        response.error = "Failed to execute curl command";
+        return response;
+    }
+
+    std::string output;
+    char buffer[READ_CHUNK];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), pipe)) > 0) {
+        output.append(buffer, n);
+        if (output.size() > max_response_size_) break;
+    }
+    int status = pclose(pipe);
+    if (output.size() > max_response_size_) {
+        response.error = "Response too large (" + url.host + ")";
+    } else if (status != 0 || output.size() < 3) {
+        response.error = "curl failed with exit status " + std::to_string(WIFEXITED(status) ? WEXITSTATUS(status) : status) +
+                         " (" + url.host + ")";
+    } else {
+        std::from_chars(output.data() + output.size() - 3, output.data() + output.size(), response.status);
+        output.resize(output.size() - 3);
+        if (sink && response.status >= 200 && response.status < 300) {
+            if (!sink(output)) response.error = "Body rejected by receiver (" + url.host + ")";
+        } else {
+            response.body = std::move(output);
+        }
+    }
+    return response;
+}
+
+HttpClientStats HttpClient::stats() const {
+    HttpClientStats stats;
+    stats.requests = requests_.load(std::memory_order_relaxed);
+    stats.connections_opened = opened_.load(std::memory_order_relaxed);
+    stats.connections_reused = reused_.load(std::memory_order_relaxed);
+    stats.retries = retries_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    for (const auto& [origin, pool] : idle_) {
+        stats.idle_connections += pool.size();
+    }
+    return stats;
+}
+
+} // namespace sec_analyzer
+
+#endif // _WIN32
@@ -0,0 +1,370 @@
+/**
+ * SEC EDGAR Fraud Analyzer - HTTP Request Parser Implementation
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ */
+
+#include <sec_analyzer/http_parser.h>
+#include <sec_analyzer/http_server.h>
+#include <sec_analyzer/util.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace sec_analyzer {
+
+namespace {
+
+Span make_span(size_t offset, size_t length) {
+    return Span{static_cast<uint32_t>(offset), static_cast<uint32_t>(length)};
+}
+
+// Trim spaces and tabs (optional whitespace around header values)
+void trim_ows(size_t& start, size_t& end, std::string_view data) {
+    while (start < end && (data[start] == ' ' || data[start] == '\t')) ++start;
+    while (end > start && (data[end - 1] == ' ' || data[end - 1] == '\t')) --end;
+}
+
+// 1*DIGIT, without overflowing size_t
+bool parse_decimal(std::string_view digits, size_t& value) {
+    if (digits.empty()) return false;
+    value = 0;
+    for (char c : digits) {
+        if (c < '0' || c > '9' || value > (SIZE_MAX - 9) / 10) return false;
+        value = value * 10 + static_cast<size_t>(c - '0');
+    }
+    return true;
+}
+
+bool is_token_char(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || std::strchr("!#$%&'*+-.^_`|~", c) != nullptr;
+}
+
+} // namespace
+
+std::string_view HttpRequestView::header(std::string_view name) const {
+    for (const auto& [key, value] : layout_->headers) {
+        if (util::iequals(key.in(base_), name)) {
+            return value.in(base_);
+        }
+    }
+    return {};
+}
+
+HttpRequest HttpRequestView::materialize(const std::string& client_ip) const {
+    HttpRequest request;
+    request.method = std::string(method());
+    request.path = std::string(path());
+    request.version = std::string(version());
+    request.query_string = std::string(query());
+    request.body = std::string(body());
+    request.client_ip = client_ip;
+
+    for (const auto& [key, value] : layout_->headers) {
+        request.headers.emplace(std::string(key.in(base_)), std::string(value.in(base_)));
+    }
+
+    // Parse query parameters
+    std::string_view qs = query();
+    while (!qs.empty()) {
+        size_t amp = qs.find('&');
+        std::string_view param = qs.substr(0, amp);
+        size_t eq_pos = param.find('=');
+        if (eq_pos != std::string_view::npos) {
+            std::string key = util::url_decode(std::string(param.substr(0, eq_pos)));
+            std::string value = util::url_decode(std::string(param.substr(eq_pos + 1)));
+            request.params[key] = value;
+        }
+        if (amp == std::string_view::npos) break;
+        qs.remove_prefix(amp + 1);
+    }
+
+    return request;
+}
+
+void HttpRequestParser::reset() {
+    state_ = State::REQUEST_LINE;
+    pos_ = 0;
+    body_start_ = 0;
+    content_length_ = 0;
+    chunk_remaining_ = 0;
+    expect_continue_ = false;
+    layout_.headers.clear();
+    layout_.method = layout_.target = layout_.path = layout_.query = Span{};
+    layout_.version = layout_.body = Span{};
+    layout_.length = 0;
+    layout_.chunked = false;
+    layout_.decoded_body.clear();
+    error_status_ = 0;
+    error_message_.clear();
+}
+
+HttpRequestParser::Status HttpRequestParser::fail(int status, const std::string& message) {
+    state_ = State::FAILED;
+    error_status_ = status;
+    error_message_ = message;
+    return Status::ERROR;
+}
+
+HttpRequestParser::Status HttpRequestParser::parse(std::string_view buffer) {
+    while (true) {
+        switch (state_) {
+            case State::REQUEST_LINE:
+            case State::HEADERS: {
+                const void* found = pos_ < buffer.size()
+                    ? std::memchr(buffer.data() + pos_, '\n', buffer.size() - pos_) : nullptr;
+                if (!found) {
+                    if (buffer.size() > MAX_HEADER_BYTES) {
+                        return fail(431, "Request Header Fields Too Large");
+                    }
+                    return Status::INCOMPLETE;
+                }
+
+                size_t line_start = pos_;
+                size_t eol = static_cast<const char*>(found) - buffer.data();
+                pos_ = eol + 1;
+                if (pos_ > MAX_HEADER_BYTES) {
+                    return fail(431, "Request Header Fields Too Large");
+                }
+
+                size_t line_end = (eol > line_start && buffer[eol - 1] == '\r') ? eol - 1 : eol;
+                std::string_view line = buffer.substr(line_start, line_end - line_start);
+
+                if (state_ == State::REQUEST_LINE) {
+                    if (line.empty()) continue;  // Tolerate leading CRLF (RFC 7230 3.5)
+                    if (!parse_request_line(line, line_start)) {
+                        return fail(400, "Malformed request line");
+                    }
+                    state_ = State::HEADERS;
+                } else if (line.empty()) {
+                    if (!finish_headers(buffer)) {
+                        return Status::ERROR;
+                    }
+                } else if (!parse_header_line(line, line_start)) {
+                    return Status::ERROR;
+                }
+                break;
+            }
+
+            case State::BODY:
+                if (buffer.size() - body_start_ < content_length_) {
+                    return Status::INCOMPLETE;
+                }
+                layout_.body = make_span(body_start_, content_length_);
+                layout_.length = body_start_ + content_length_;
+                state_ = State::DONE;
+                return Status::COMPLETE;
+
+            case State::CHUNK_SIZE:
+            case State::CHUNK_DATA:
+            case State::CHUNK_TRAILERS:
+                return parse_chunked(buffer);
+
+            case State::DONE:
+                return Status::COMPLETE;
+
+            case State::FAILED:
+                return Status::ERROR;
+        }
+    }
+}
+
+bool HttpRequestParser::parse_request_line(std::string_view line, size_t line_start) {
+    size_t sp1 = line.find(' ');
+    if (sp1 == std::string_view::npos || sp1 == 0) return false;
+    size_t sp2 = line.find(' ', sp1 + 1);
+    if (sp2 == std::string_view::npos || sp2 == sp1 + 1) return false;
+
+    for (size_t i = 0; i < sp1; ++i) {
+        if (!is_token_char(line[i])) return false;
+    }
+
+    std::string_view version = line.substr(sp2 + 1);
+    if (version.substr(0, 5) != "HTTP/") return false;
+
+    layout_.method = make_span(line_start, sp1);
+    layout_.target = make_span(line_start + sp1 + 1, sp2 - sp1 - 1);
+    layout_.version = make_span(line_start + sp2 + 1, version.size());
+
+    std::string_view target = line.substr(sp1 + 1, sp2 - sp1 - 1);
+    size_t query_pos = target.find('?');
+    if (query_pos == std::string_view::npos) {
+        layout_.path = layout_.target;
+    } else {
+        layout_.path = make_span(layout_.target.offset, query_pos);
+        layout_.query = make_span(layout_.target.offset + query_pos + 1, target.size() - query_pos - 1);
+    }
+    return true;
+}
+
+bool HttpRequestParser::parse_header_line(std::string_view line, size_t line_start) {
+    if (layout_.headers.size() >= MAX_HEADER_COUNT) {
+        fail(431, "Too many headers");
+        return false;
+    }
+
+    size_t colon = line.find(':');
+    if (colon == std::string_view::npos || colon == 0) {
+        fail(400, "Malformed header");
+        return false;
+    }
+    for (size_t i = 0; i < colon; ++i) {
+        if (!is_token_char(line[i])) {
+            fail(400, "Malformed header name");
+            return false;
+        }
+    }
+
+    size_t value_start = colon + 1;
+    size_t value_end = line.size();
+    trim_ows(value_start, value_end, line);
+
+    layout_.headers.emplace_back(make_span(line_start, colon),
+                                 make_span(line_start + value_start, value_end - value_start));
+    return true;
+}
+
+bool HttpRequestParser::finish_headers(std::string_view buffer) {
+    body_start_ = pos_;
+    content_length_ = 0;
+
+    HttpRequestView view(buffer, layout_);
+
+    // Repeated fields and comma-separated lists are accepted only when every
+    // value is the same; anything else is ambiguous framing (RFC 7230 3.3.3)
+    bool has_length = false;
+    for (const auto& [key, value] : layout_.headers) {
+        if (!util::iequals(key.in(buffer), "Content-Length")) continue;
+        std::string_view list = value.in(buffer);
+        size_t start = 0;
+        while (true) {
+            size_t comma = std::min(list.find(',', start), list.size());
+            size_t item_start = start;
+            size_t item_end = comma;
+            trim_ows(item_start, item_end, list);
+            size_t length = 0;
+            if (!parse_decimal(list.substr(item_start, item_end - item_start), length)) {
+                fail(400, "Invalid Content-Length");
+                return false;
+            }
+            if (has_length && length != content_length_) {
+                fail(400, "Conflicting Content-Length values");
+                return false;
+            }
+            content_length_ = length;
+            has_length = true;
+            if (comma == list.size()) break;
+            start = comma + 1;
+        }
+    }
+
+    expect_continue_ = util::iequals(view.header("Expect"), "100-continue");
+
+    std::string_view encoding = view.header("Transfer-Encoding");
+    if (!encoding.empty()) {
+        // Both framings at once is a request smuggling vector (RFC 7230 3.3.3)
+        if (has_length) {
+            fail(400, "Both Content-Length and Transfer-Encoding present");
+            return false;
+        }
+        if (!util::iequals(encoding, "chunked")) {
+            fail(501, "Transfer-Encoding not supported");
+            return false;
+        }
+        layout_.chunked = true;
+        state_ = State::CHUNK_SIZE;
+        return true;
+    }
+
+    // Reject before buffering anything
+    if (content_length_ > max_body_size_) {
+        fail(413, "Payload Too Large");
+        return false;
+    }
+
+    state_ = State::BODY;
+    return true;
+}
+
+HttpRequestParser::Status HttpRequestParser::parse_chunked(std::string_view buffer) {
+    while (true) {
+        if (state_ == State::CHUNK_DATA) {
+            size_t available = std::min(buffer.size() - pos_, chunk_remaining_);
+            layout_.decoded_body.append(buffer.data() + pos_, available);
+            pos_ += available;
+            chunk_remaining_ -= available;
+            if (chunk_remaining_ > 0) {
+                return Status::INCOMPLETE;
+            }
+
+            // Chunk data is followed by CRLF
+            if (buffer.size() - pos_ < 2) {
+                return Status::INCOMPLETE;
+            }
+            if (buffer[pos_] != '\r' || buffer[pos_ + 1] != '\n') {
+                return fail(400, "Malformed chunk");
+            }
+            pos_ += 2;
+            state_ = State::CHUNK_SIZE;
+            continue;
+        }
+
+        const void* found = pos_ < buffer.size()
+            ? std::memchr(buffer.data() + pos_, '\n', buffer.size() - pos_) : nullptr;
+        if (!found) {
+            if (buffer.size() - pos_ > MAX_HEADER_BYTES) {
+                return fail(400, "Malformed chunk");
+            }
+            return Status::INCOMPLETE;
+        }
+
+        size_t line_start = pos_;
+        size_t eol = static_cast<const char*>(found) - buffer.data();
+        pos_ = eol + 1;
+        size_t line_end = (eol > line_start && buffer[eol - 1] == '\r') ? eol - 1 : eol;
+        std::string_view line = buffer.substr(line_start, line_end - line_start);
+
+        if (state_ == State::CHUNK_TRAILERS) {
+            // Trailer fields are not surfaced to handlers
+            if (line.empty()) {
+                layout_.length = pos_;
+                state_ = State::DONE;
+                return Status::COMPLETE;
+            }
+            continue;
+        }
+
+        // chunk-size [ ";" chunk-ext ]
+        size_t size = 0;
+        size_t digits = 0;
+        for (char c : line) {
+            int nibble;
+            if (c >= '0' && c <= '9') nibble = c - '0';
+            else if (c >= 'a' && c <= 'f') nibble = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') nibble = c - 'A' + 10;
+            else break;
+            if (size > (SIZE_MAX >> 4)) {
+                return fail(413, "Payload Too Large");
+            }
+            size = (size << 4) | static_cast<size_t>(nibble);
+            ++digits;
+        }
+        if (digits == 0) {
+            return fail(400, "Malformed chunk size");
+        }
+
+        if (size == 0) {
+            state_ = State::CHUNK_TRAILERS;
+            continue;
+        }
+        if (size > max_body_size_ - std::min(max_body_size_, layout_.decoded_body.size())) {
+            return fail(413, "Payload Too Large");
+        }
+
+        chunk_remaining_ = size;
+        layout_.decoded_body.reserve(layout_.decoded_body.size() + size);
+        state_ = State::CHUNK_DATA;
+    }
+}
+
+} // namespace sec_analyzer
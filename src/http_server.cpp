@@ -5,16 +5,274 @@
  */
 
 #include <sec_analyzer/http_server.h>
+#include <sec_analyzer/compression.h>
 #include <sec_analyzer/logger.h>
 #include <sec_analyzer/util.h>
+#include <sec_analyzer/timer_wheel.h>
+#include <sec_analyzer/metrics.h>
 
 #include <sstream>
 #include <fstream>
+#include <filesystem>
 #include <algorithm>
+#include <charconv>
+#include <climits>
 #include <cstring>
+#include <future>
+#include <tuple>
+
+#ifndef _WIN32
+#include <sys/uio.h>
+#include <cerrno>
+#endif
+
+#ifdef __linux__
+#define SEC_ANALYZER_HAS_EPOLL 1
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/sendfile.h>
+#include <pthread.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <poll.h>
+#endif
 
 namespace sec_analyzer {
 
+namespace {
+
+// Interim response for "Expect: 100-continue" (RFC 7231 5.1.1)
+constexpr char CONTINUE_RESPONSE[] = "HTTP/1.1 100 Continue\r\n\r\n";
+
+void append_number(std::string& out, long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+#ifndef _WIN32
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+// Point iov at the unsent part of head + body; returns the iovec count
+int fill_iovecs(std::string_view head, std::string_view body, size_t offset, iovec iov[2]) {
+    int count = 0;
+    if (offset < head.size()) {
+        iov[count].iov_base = const_cast<char*>(head.data() + offset);
+        iov[count].iov_len = head.size() - offset;
+        ++count;
+        offset = 0;
+    } else {
+        offset -= head.size();
+    }
+    if (offset < body.size()) {
+        iov[count].iov_base = const_cast<char*>(body.data() + offset);
+        iov[count].iov_len = body.size() - offset;
+        ++count;
+    }
+    return count;
+}
+#endif
+
+// Blocking write of head then body without joining them; false if the peer went away
+bool send_response(socket_t sock, std::string_view head, std::string_view body) {
+#ifdef _WIN32
+    for (std::string_view part : {head, body}) {
+        while (!part.empty()) {
+            int chunk = static_cast<int>(std::min<size_t>(part.size(), INT_MAX));
+            int n = send(sock, part.data(), chunk, 0);
+            if (n <= 0) return false;
+            part.remove_prefix(static_cast<size_t>(n));
+        }
+    }
+    return true;
+#else
+    size_t offset = 0;
+    size_t total = head.size() + body.size();
+    while (offset < total) {
+        iovec iov[2];
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = static_cast<size_t>(fill_iovecs(head, body, offset, iov));
+        ssize_t n = sendmsg(sock, &msg, SEND_FLAGS);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        offset += static_cast<size_t>(n);
+    }
+    return true;
+#endif
+}
+
+// Frame one piece of a chunked body (RFC 7230 4.1); `last` adds the terminating chunk
+void append_chunk(std::string& out, std::string_view data, bool last) {
+    if (!data.empty()) {
+        char size[16];
+        auto result = std::to_chars(size, size + sizeof(size), data.size(), 16);
+        out.append(size, result.ptr).append("\r\n");
+        out.append(data).append("\r\n");
+    }
+    if (last) {
+        out.append("0\r\n\r\n");
+    }
+}
+
+// Collects a pushed stream into a plain body (HTTP/1.0 clients)
+class BufferSink : public ResponseSink {
+public:
+    explicit BufferSink(std::string& out) : out_(out) {}
+    bool write(std::string_view data) override {
+        out_.append(data);
+        return true;
+    }
+private:
+    std::string& out_;
+};
+
+// Collects an async stream into response->body (HTTP/1.0 clients), then calls
+// done; each piece continues from whichever thread delivered it
+void gather_body(const std::shared_ptr<HttpResponse>& response,
+                 const std::shared_ptr<AsyncBodyProducer>& producer, std::function<void()> done) {
+    try {
+        (*producer)([response, producer, done](std::string piece, bool more) {
+            response->body.append(piece);
+            if (more) {
+                gather_body(response, producer, done);
+                return;
+            }
+            done();
+        });
+    } catch (const std::exception& e) {
+        LOG_ERROR("Response stream failed: {}", e.what());
+        *response = HttpResponse::internal_error(e.what());
+        done();
+    }
+}
+
+// Blocking write of a file body; sendfile where available, buffered reads elsewhere.
+// One sendfile call can block far past SO_SNDTIMEO, so the socket is made
+// non-blocking and each wait for buffer space is bounded by timeout_seconds.
+bool send_file(socket_t sock, const std::string& path, size_t size, int timeout_seconds) {
+#ifdef SEC_ANALYZER_HAS_EPOLL
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    int flags = fcntl(sock, F_GETFL, 0);
+    fcntl(sock, F_SETFL, flags | O_NONBLOCK);
+    off_t offset = 0;
+    bool ok = true;
+    while (static_cast<size_t>(offset) < size) {
+        ssize_t n = sendfile(sock, fd, &offset, size - static_cast<size_t>(offset));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            pollfd pfd{sock, POLLOUT, 0};
+            if (poll(&pfd, 1, timeout_seconds * 1000) > 0) continue;
+        }
+        if (n <= 0) {
+            ok = false;
+            break;
+        }
+    }
+    fcntl(sock, F_SETFL, flags);
+    close(fd);
+    return ok;
+#else
+    (void)timeout_seconds;
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    char buffer[64 * 1024];
+    size_t remaining = size;
+    while (remaining > 0) {
+        file.read(buffer, static_cast<std::streamsize>(std::min(remaining, sizeof(buffer))));
+        size_t count = static_cast<size_t>(file.gcount());
+        if (count == 0 || !send_response(sock, std::string_view(buffer, count), {})) return false;
+        remaining -= count;
+    }
+    return true;
+#endif
+}
+
+/**
+ * Shared by every copy of a deferred request's ResponseCallback. Answers
+ * once; if the last copy is dropped unanswered (a handler bug, or its
+ * executor shutting down) the client gets a 503 instead of a hung socket.
+ */
+class DeferredResponse {
+public:
+    explicit DeferredResponse(ResponseCallback respond) : respond_(std::move(respond)) {}
+    
+    ~DeferredResponse() {
+        if (done_.exchange(true)) return;
+        LOG_WARNING("Deferred request dropped without a response");
+        try {
+            respond_(HttpResponse::error(503, "Service Unavailable"));
+        } catch (const std::exception& e) {
+            LOG_ERROR("Failed to answer dropped request: {}", e.what());
+        }
+    }
+    
+    void complete(HttpResponse response) {
+        if (done_.exchange(true)) {
+            LOG_WARNING("Ignoring duplicate response for a deferred request");
+            return;
+        }
+        respond_(std::move(response));
+    }
+    
+private:
+    ResponseCallback respond_;
+    std::atomic<bool> done_{false};
+};
+
+void set_socket_timeout(socket_t sock, int option, int seconds) {
+#ifdef _WIN32
+    DWORD timeout = static_cast<DWORD>(seconds) * 1000;
+    setsockopt(sock, SOL_SOCKET, option, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+#else
+    timeval timeout{};
+    timeout.tv_sec = seconds;
+    setsockopt(sock, SOL_SOCKET, option, &timeout, sizeof(timeout));
+#endif
+}
+
+// Request latency by route pattern (never the raw path, which is unbounded), method and status
+void record_request(const std::string& route, std::string_view method, int status,
+                    std::chrono::steady_clock::duration elapsed) {
+    static HistogramFamily& latency = MetricsRegistry::instance().histogram(
+        "http_request_duration_seconds",
+        "Time from queueing a request for a worker to its response, by route pattern",
+        {"route", "method", "status"});
+    
+    static constexpr std::string_view KNOWN_METHODS[] = {"GET", "HEAD", "POST", "PUT", "DELETE", "PATCH", "OPTIONS"};
+    if (std::find(std::begin(KNOWN_METHODS), std::end(KNOWN_METHODS), method) == std::end(KNOWN_METHODS)) {
+        method = "other";
+    }
+    char code[8];
+    auto result = std::to_chars(code, code + sizeof(code), status);
+    latency.with({route, method, std::string_view(code, static_cast<size_t>(result.ptr - code))})
+        .observe(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+}
+
+// If-None-Match against a strong tag; weak comparison per RFC 7232 3.2
+bool etag_matches(std::string_view if_none_match, std::string_view etag) {
+    if (if_none_match.empty()) return false;
+    while (!if_none_match.empty()) {
+        size_t comma = if_none_match.find(',');
+        std::string_view candidate = if_none_match.substr(0, comma);
+        if_none_match.remove_prefix(comma == std::string_view::npos ? if_none_match.size() : comma + 1);
+        
+        while (!candidate.empty() && candidate.front() == ' ') candidate.remove_prefix(1);
+        while (!candidate.empty() && candidate.back() == ' ') candidate.remove_suffix(1);
+        if (candidate == "*") return true;
+        if (candidate.substr(0, 2) == "W/") candidate.remove_prefix(2);
+        if (candidate == etag) return true;
+    }
+    return false;
+}
+
+} // namespace
+
 HttpServer::HttpServer() {
     init_sockets();
 }
@@ -56,23 +314,729 @@ void HttpServer::del(const std::string& path, RequestHandler handler) {
 }
 
 void HttpServer::route(const std::string& method, const std::string& path, RequestHandler handler) {
-    std::lock_guard<std::mutex> lock(handlers_mutex_);
-    handlers_[{method, path}] = handler;
+    add_route(method, path, Route{std::move(handler), nullptr, {}});
 }
 
-bool HttpServer::start() {
-    server_socket_ = socket(AF_INET, SOCK_STREAM, 0);
-    if (server_socket_ == INVALID_SOCKET_VALUE) {
+void HttpServer::get_async(const std::string& path, AsyncRequestHandler handler) {
+    route_async("GET", path, std::move(handler));
+}
+
+void HttpServer::route_async(const std::string& method, const std::string& path, AsyncRequestHandler handler) {
+    add_route(method, path, Route{nullptr, std::move(handler), {}});
+}
+
+void HttpServer::add_route(const std::string& method, const std::string& path, Route route) {
+    std::lock_guard<std::mutex> lock(routes_write_mutex_);
+    route.pattern = path;
+    
+    auto next = std::make_unique<RouteTable>();
+    for (const auto& [def_method, def_path, def_route] : route_definitions_) {
+        next->add(def_method, def_path, def_route);
+    }
+    // Throws on a malformed pattern before anything is published
+    next->add(method, path, route);
+    
+    auto existing = std::find_if(route_definitions_.begin(), route_definitions_.end(), [&](const auto& def) {
+        return std::get<0>(def) == method && std::get<1>(def) == path;
+    });
+    if (existing != route_definitions_.end()) {
+        std::get<2>(*existing) = std::move(route);
+    } else {
+        route_definitions_.emplace_back(method, path, std::move(route));
+    }
+    
+    routes_.store(next.get(), std::memory_order_release);
+    route_snapshots_.push_back(std::move(next));
+}
+
+#ifdef SEC_ANALYZER_HAS_EPOLL
+
+namespace {
+
+constexpr int MAX_EPOLL_EVENTS = 256;
+constexpr size_t READ_CHUNK_SIZE = 16 * 1024;
+
+bool set_non_blocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// What a connection is currently waiting for, and so which timeout applies
+enum class Deadline {
+    NONE,       // Handler or stream producer running; the server is the slow side
+    IDLE,       // Between requests (keep-alive)
+    HEADER,     // Request started, headers incomplete; not extended by progress
+    BODY,       // Reading the body; extended whenever bytes arrive
+    WRITE       // Response bytes unsent; extended whenever bytes leave
+};
+
+const char* deadline_name(Deadline kind) {
+    switch (kind) {
+        case Deadline::IDLE: return "idle";
+        case Deadline::HEADER: return "header";
+        case Deadline::BODY: return "body";
+        case Deadline::WRITE: return "write";
+        default: return "none";
+    }
+}
+
+} // namespace
+
+/**
+ * Per-socket state owned by exactly one event loop. Workers only hold a
+ * shared_ptr to it and hand results back through EventLoop::post().
+ */
+struct HttpServer::Connection {
+    int fd = -1;
+    std::string client_ip;
+    std::string in;             // Bytes received but not yet dispatched
+    size_t in_start = 0;        // First byte of the request being parsed
+    HttpRequestParser parser;
+    std::string head;           // Rendered status line + headers; capacity reused per request
+    std::string body;           // Response body, moved from the handler's HttpResponse
+    std::shared_ptr<const std::string> shared_body;  // Cached body, used instead of body
+    size_t out_offset = 0;      // Bytes of head + body already written
+    int file_fd = -1;           // File body sent with sendfile after head + body
+    off_t file_offset = 0;
+    size_t file_end = 0;
+    BodyProducer producer;      // Streamed body; body holds one framed chunk at a time
+    // Same, with pieces delivered later from any thread; shared so a worker
+    // still returning from it never sees it released
+    std::shared_ptr<AsyncBodyProducer> async_producer;
+    bool push_stream = false;   // Body chunks arrive from a StreamWriter via post()
+    bool stream_done = false;   // Terminating chunk is in body
+    std::atomic<bool> closed{false};
+    bool busy = false;          // Request currently running on a worker
+    bool peer_closed = false;
+    bool read_paused = false;   // Stopped at the buffer cap; unread bytes wait in the kernel
+    bool continue_sent = false; // Interim 100 Continue already written
+    bool keep_alive = false;    // Keep open once the current response is written
+    int requests_served = 0;
+    TimerWheel::Timer deadline;         // Owned by the loop's wheel while armed
+    Deadline deadline_kind = Deadline::NONE;
+    bool progressed = false;            // Bytes moved since the deadline was last checked
+};
+
+/**
+ * One epoll instance plus its I/O thread. Loop 0 also owns the listening
+ * socket and spreads accepted connections over all loops round-robin.
+ */
+class HttpServer::EventLoop : public std::enable_shared_from_this<HttpServer::EventLoop> {
+public:
+    EventLoop(HttpServer& server, int listen_fd) : server_(server), listen_fd_(listen_fd) {}
+    
+    ~EventLoop() {
+        for (auto& [fd, conn] : connections_) {
+            wheel_.cancel(conn->deadline);
+            CLOSE_SOCKET(fd);
+            conn->fd = -1;
+            conn->closed = true;
+        }
+        if (wake_fd_ >= 0) close(wake_fd_);
+        if (epoll_fd_ >= 0) close(epoll_fd_);
+    }
+    
+    bool init() {
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epoll_fd_ < 0 || wake_fd_ < 0) return false;
+        
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLET;
+        ev.data.fd = wake_fd_;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev) < 0) return false;
+        
+        if (listen_fd_ >= 0) {
+            ev.events = EPOLLIN | EPOLLET;
+            ev.data.fd = listen_fd_;
+            if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &ev) < 0) return false;
+        }
+        return true;
+    }
+    
+    void run() {
+        epoll_event events[MAX_EPOLL_EVENTS];
+        
+        while (server_.running_) {
+            // Wake every tick while deadlines are pending
+            int timeout = wheel_.size() > 0 ? static_cast<int>(wheel_.tick().count()) : 500;
+            int count = epoll_wait(epoll_fd_, events, MAX_EPOLL_EVENTS, timeout);
+            if (count < 0) {
+                if (errno == EINTR) continue;
+                LOG_ERROR("epoll_wait failed: {}", std::strerror(errno));
+                break;
+            }
+            
+            for (int i = 0; i < count; ++i) {
+                int fd = events[i].data.fd;
+                if (fd == wake_fd_) {
+                    uint64_t value;
+                    while (read(wake_fd_, &value, sizeof(value)) > 0) {}
+                    continue;
+                }
+                if (fd == listen_fd_) {
+                    on_accept();
+                    continue;
+                }
+                
+                auto it = connections_.find(fd);
+                if (it == connections_.end()) continue;
+                auto conn = it->second;
+                
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    close_connection(conn);
+                    continue;
+                }
+                if (events[i].events & EPOLLIN) {
+                    on_readable(conn);
+                }
+                if (conn->fd >= 0 && (events[i].events & EPOLLOUT)) {
+                    flush(conn);
+                }
+                update_deadline(conn);
+            }
+            
+            run_pending();
+            expire_deadlines();
+        }
+    }
+    
+    // Queue work for the I/O thread; safe to call from any thread
+    void post(std::function<void()> fn) {
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            pending_.push_back(std::move(fn));
+        }
+        wake();
+    }
+    
+    void wake() {
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t n = write(wake_fd_, &one, sizeof(one));
+    }
+    
+    void add_connection(int fd, const std::string& client_ip) {
+        auto conn = std::make_shared<Connection>();
+        conn->fd = fd;
+        conn->client_ip = client_ip;
+        conn->parser.set_max_body_size(server_.max_body_size_);
+        
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            LOG_WARNING("Failed to register connection from {}", client_ip);
+            CLOSE_SOCKET(fd);
+            return;
+        }
+        connections_[fd] = conn;
+        conn->deadline.data = fd;
+        update_deadline(conn);
+    }
+    
+    std::thread thread;
+
+private:
+    HttpServer& server_;
+    int listen_fd_;
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::unordered_map<int, std::shared_ptr<Connection>> connections_;
+    std::mutex pending_mutex_;
+    std::vector<std::function<void()>> pending_;
+    size_t next_loop_ = 0;
+    TimerWheel wheel_;
+    std::vector<TimerWheel::Timer*> expired_;
+    
+    std::chrono::milliseconds timeout_for(Deadline kind) const {
+        int seconds = 0;
+        switch (kind) {
+            case Deadline::IDLE: seconds = server_.keep_alive_timeout_seconds_; break;
+            case Deadline::HEADER: seconds = server_.header_timeout_seconds_; break;
+            case Deadline::BODY: seconds = server_.body_timeout_seconds_; break;
+            case Deadline::WRITE: seconds = server_.write_timeout_seconds_; break;
+            default: break;
+        }
+        return std::chrono::seconds(std::max(1, seconds));
+    }
+    
+    // Largest request the parser accepts; reads stop once this much is waiting
+    size_t max_buffered() const {
+        return HttpRequestParser::MAX_HEADER_BYTES + server_.max_body_size_;
+    }
+    
+    static bool has_unsent(const Connection& conn) {
+        size_t body = conn.shared_body ? conn.shared_body->size() : conn.body.size();
+        return conn.out_offset < conn.head.size() + body ||
+               (conn.file_fd >= 0 && static_cast<size_t>(conn.file_offset) < conn.file_end);
+    }
+    
+    // Re-derive the connection's deadline from its state; call after anything that changes it
+    void update_deadline(const std::shared_ptr<Connection>& conn) {
+        if (conn->fd < 0) return;
+        
+        Deadline kind;
+        if (conn->busy) {
+            kind = Deadline::NONE;
+        } else if (!conn->head.empty()) {
+            // A push stream waiting on its writer is not the client's fault
+            kind = has_unsent(*conn) ? Deadline::WRITE : Deadline::NONE;
+        } else if (conn->parser.awaiting_body()) {
+            kind = Deadline::BODY;
+        } else if (conn->in.size() > conn->in_start) {
+            kind = Deadline::HEADER;
+        } else {
+            kind = Deadline::IDLE;
+        }
+        
+        bool extend = conn->progressed && (kind == Deadline::BODY || kind == Deadline::WRITE);
+        conn->progressed = false;
+        if (kind == conn->deadline_kind && !extend) return;
+        
+        conn->deadline_kind = kind;
+        if (kind == Deadline::NONE) {
+            wheel_.cancel(conn->deadline);
+        } else {
+            wheel_.schedule(conn->deadline, timeout_for(kind));
+        }
+    }
+    
+    // Closes connections whose deadline passed; header/body timeouts get a 408 first
+    void expire_deadlines() {
+        if (wheel_.size() == 0) return;
+        expired_.clear();
+        wheel_.advance(std::chrono::steady_clock::now(), expired_);
+        
+        for (TimerWheel::Timer* timer : expired_) {
+            auto it = connections_.find(timer->data);
+            if (it == connections_.end() || &it->second->deadline != timer) continue;
+            auto conn = it->second;
+            
+            LOG_DEBUG("Closing connection from {}: {} deadline passed",
+                      conn->client_ip, deadline_name(conn->deadline_kind));
+            if (conn->deadline_kind == Deadline::HEADER || conn->deadline_kind == Deadline::BODY) {
+                // Best effort; the socket is closed either way
+                HttpResponse timeout = HttpResponse::error(408, "Request Timeout");
+                std::string out;
+                server_.render_head(timeout, false, out);
+                out += timeout.body;
+                send(conn->fd, out.data(), out.size(), MSG_NOSIGNAL);
+            }
+            close_connection(conn);
+        }
+    }
+    
+    void run_pending() {
+        std::vector<std::function<void()>> work;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            work.swap(pending_);
+        }
+        for (auto& fn : work) {
+            fn();
+        }
+    }
+    
+    void on_accept() {
+        while (true) {
+            sockaddr_in client_addr{};
+            socklen_t client_len = sizeof(client_addr);
+            int fd = accept4(listen_fd_, reinterpret_cast<sockaddr*>(&client_addr),
+                             &client_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR) continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK && server_.running_) {
+                    LOG_WARNING("Accept failed: {}", std::strerror(errno));
+                }
+                return;
+            }
+            
+            char ip_str[INET_ADDRSTRLEN];
+            inet_ntop(AF_INET, &client_addr.sin_addr, ip_str, INET_ADDRSTRLEN);
+            std::string client_ip = ip_str;
+            
+            // With SO_REUSEPORT the kernel already spread connections over the loops
+            auto& loops = server_.event_loops_;
+            EventLoop* target = server_.reuse_port_active_ ? this : loops[next_loop_++ % loops.size()].get();
+            if (target == this) {
+                add_connection(fd, client_ip);
+            } else {
+                target->post([target, fd, client_ip]() {
+                    target->add_connection(fd, client_ip);
+                });
+            }
+        }
+    }
+    
+    void on_readable(const std::shared_ptr<Connection>& conn) {
+        char buffer[READ_CHUNK_SIZE];
+        
+        // Drop already-dispatched pipelined bytes; parser offsets are
+        // relative to in_start so they survive the move
+        if (conn->in_start > READ_CHUNK_SIZE) {
+            conn->in.erase(0, conn->in_start);
+            conn->in_start = 0;
+        }
+        
+        // A client pipelining behind a slow request would otherwise grow
+        // in without bound; past the cap TCP flow control holds it back
+        conn->read_paused = false;
+        while (true) {
+            if (conn->in.size() - conn->in_start >= max_buffered()) {
+                conn->read_paused = true;
+                break;
+            }
+            ssize_t n = recv(conn->fd, buffer, sizeof(buffer), 0);
+            if (n > 0) {
+                conn->in.append(buffer, static_cast<size_t>(n));
+                conn->progressed = true;
+                continue;
+            }
+            if (n == 0) {
+                conn->peer_closed = true;
+                break;
+            }
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            close_connection(conn);
+            return;
+        }
+        
+        // A response still being written resumes dispatch once it drains
+        if (!conn->busy && conn->head.empty()) {
+            try_dispatch(conn);
+        }
+    }
+    
+    void try_dispatch(const std::shared_ptr<Connection>& conn) {
+        std::string_view pending(conn->in);
+        pending.remove_prefix(conn->in_start);
+        
+        auto status = pending.empty() ? HttpRequestParser::Status::INCOMPLETE
+                                      : conn->parser.parse(pending);
+        if (status == HttpRequestParser::Status::INCOMPLETE) {
+            if (conn->peer_closed) {
+                close_connection(conn);
+                return;
+            }
+            if (pending.size() >= max_buffered()) {
+                // Only chunk framing can push a request within the parser's limits this far
+                LOG_WARNING("Request from {} exceeds {} buffered bytes", conn->client_ip, max_buffered());
+                complete(conn, HttpResponse::error(413, "Payload Too Large"), false);
+                return;
+            }
+            if (conn->read_paused) {
+                // Edge-triggered: bytes left in the kernel raise no new event
+                on_readable(conn);
+                return;
+            }
+            if (conn->parser.awaiting_body() && conn->parser.expects_continue() && !conn->continue_sent) {
+                // Headers passed the size checks; let the client send the body
+                conn->continue_sent = true;
+                send(conn->fd, CONTINUE_RESPONSE, sizeof(CONTINUE_RESPONSE) - 1, MSG_NOSIGNAL);
+            }
+            return;
+        }
+        if (status == HttpRequestParser::Status::ERROR) {
+            LOG_WARNING("Bad request from {}: {}", conn->client_ip, conn->parser.error_message());
+            complete(conn, HttpResponse::error(conn->parser.error_status(), conn->parser.error_message()), false);
+            return;
+        }
+        
+        // Hand the request bytes to the worker. The common single-request
+        // case moves the whole buffer; pipelined requests copy their slice
+        // and stay queued so responses go out in request order.
+        HttpRequestLayout layout = conn->parser.take_layout();
+        conn->parser.reset();
+        conn->continue_sent = false;
+        std::string raw;
+        if (conn->in_start == 0 && layout.length == conn->in.size()) {
+            raw.swap(conn->in);
+        } else {
+            raw.assign(conn->in, conn->in_start, layout.length);
+            conn->in_start += layout.length;
+            if (conn->in_start == conn->in.size()) {
+                conn->in.clear();
+                conn->in_start = 0;
+            }
+        }
+        conn->busy = true;
+        conn->requests_served++;
+        
+        bool allow_keep_alive = server_.keep_alive_timeout_seconds_ > 0 &&
+                                conn->requests_served < server_.max_requests_per_connection_ &&
+                                !conn->peer_closed;
+        
+        auto queued_at = std::chrono::steady_clock::now();
+        bool queued = server_.worker_pool_->submit(
+            [this, conn, raw = std::move(raw), layout = std::move(layout), allow_keep_alive, queued_at]() {
+            // An async handler may answer after this task returns; the
+            // connection stays busy (and out of the idle sweep) until then
+            server_.process_request(raw, layout, conn->client_ip, allow_keep_alive,
+                std::chrono::steady_clock::now() - queued_at,
+                [loop = shared_from_this(), conn](HttpResponse response, bool keep_alive) {
+                StreamWriter writer = response.stream_writer;
+                EventLoop* self = loop.get();
+                loop->post([self, conn, response = std::move(response), keep_alive]() mutable {
+                    self->complete(conn, std::move(response), keep_alive);
+                });
+                if (writer) {
+                    loop->run_stream(conn, writer);
+                }
+            });
+        });
+        
+        if (!queued) {
+            complete(conn, server_.overloaded_response(), false);
+        }
+    }
+    
+    void complete(const std::shared_ptr<Connection>& conn, HttpResponse response, bool keep_alive) {
+        conn->busy = false;
+        if (conn->fd < 0) return;
+        conn->keep_alive = keep_alive;
+        
+        if (!response.file_path.empty()) {
+            conn->file_fd = open(response.file_path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (conn->file_fd < 0) {
+                response = HttpResponse::not_found();
+            }
+            conn->file_offset = 0;
+            conn->file_end = response.file_size;
+        }
+        
+        server_.render_head(response, keep_alive, conn->head);
+        conn->body = std::move(response.body);
+        conn->shared_body = std::move(response.shared_body);
+        conn->producer = std::move(response.producer);
+        conn->async_producer = response.async_producer
+            ? std::make_shared<AsyncBodyProducer>(std::move(response.async_producer)) : nullptr;
+        conn->push_stream = static_cast<bool>(response.stream_writer);
+        conn->stream_done = false;
+        conn->out_offset = 0;
+        conn->progressed = true;
+        flush(conn);
+        update_deadline(conn);
+    }
+    
+    void flush(const std::shared_ptr<Connection>& conn) {
+        std::string_view body = conn->shared_body ? std::string_view(*conn->shared_body)
+                                                  : std::string_view(conn->body);
+        size_t total = conn->head.size() + body.size();
+        while (conn->out_offset < total) {
+            // Head and body go out in one syscall without being joined
+            iovec iov[2];
+            msghdr msg{};
+            msg.msg_iov = iov;
+            msg.msg_iovlen = static_cast<size_t>(fill_iovecs(conn->head, body, conn->out_offset, iov));
+            ssize_t n = sendmsg(conn->fd, &msg, MSG_NOSIGNAL);
+            if (n > 0) {
+                conn->out_offset += static_cast<size_t>(n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;  // Wait for EPOLLOUT
+            close_connection(conn);
+            return;
+        }
+        
+        while (conn->file_fd >= 0 && static_cast<size_t>(conn->file_offset) < conn->file_end) {
+            ssize_t n = sendfile(conn->fd, conn->file_fd, &conn->file_offset,
+                                 conn->file_end - static_cast<size_t>(conn->file_offset));
+            if (n > 0) continue;
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+            close_connection(conn);  // Error, or the file shrank under us
+            return;
+        }
+        
+        if (conn->head.empty()) return;
+        
+        // Streamed body: everything so far is out, fetch the next chunk
+        if ((conn->producer || conn->async_producer) && !conn->stream_done) {
+            conn->body.clear();
+            conn->out_offset = conn->head.size();
+            produce_chunk(conn);
+            return;
+        }
+        
+        // Pushed stream: wait for the writer to post more
+        if (conn->push_stream && !conn->stream_done) {
+            conn->body.clear();
+            conn->out_offset = conn->head.size();
+            return;
+        }
+        
+        // Response fully written; clear() keeps the head buffer's capacity
+        conn->producer = nullptr;
+        conn->async_producer = nullptr;
+        conn->push_stream = false;
+        conn->head.clear();
+        conn->body = std::string();
+        conn->shared_body.reset();
+        close_file(conn);
+        conn->out_offset = 0;
+        conn->progressed = true;
+        if (!conn->keep_alive) {
+            close_connection(conn);
+            return;
+        }
+        try_dispatch(conn);
+    }
+    
+    // Posts each write to this loop as a chunk of the connection's body
+    class StreamSink : public ResponseSink {
+    public:
+        StreamSink(EventLoop* loop, std::shared_ptr<Connection> conn) : loop_(loop), conn_(std::move(conn)) {}
+        
+        bool write(std::string_view data) override {
+            if (conn_->closed) return false;
+            if (data.empty()) return true;
+            std::string framed;
+            append_chunk(framed, data, false);
+            loop_->post([loop = loop_, conn = conn_, framed = std::move(framed)]() mutable {
+                loop->append_stream(conn, std::move(framed), false);
+            });
+            return true;
+        }
+        
+    private:
+        EventLoop* loop_;
+        std::shared_ptr<Connection> conn_;
+    };
+    
+    // Runs on the worker that produced the response, after complete() was posted
+    void run_stream(const std::shared_ptr<Connection>& conn, const StreamWriter& writer) {
+        StreamSink sink(this, conn);
+        bool failed = false;
+        try {
+            writer(sink);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Response stream failed: {}", e.what());
+            failed = true;
+        }
+        post([this, conn, failed]() {
+            if (failed) {
+                close_connection(conn);
+                return;
+            }
+            std::string last;
+            append_chunk(last, {}, true);
+            append_stream(conn, std::move(last), true);
+        });
+    }
+    
+    void append_stream(const std::shared_ptr<Connection>& conn, std::string framed, bool last) {
+        if (conn->fd < 0) return;
+        conn->body.append(framed);
+        conn->stream_done = last;
+        conn->progressed = true;
+        flush(conn);
+        update_deadline(conn);
+    }
+    
+    // One chunk in flight at a time, so a slow reader throttles the producer.
+    // An async producer only starts its piece here; the worker does not wait
+    // for it, and whichever thread finishes the piece posts it back.
+    void produce_chunk(const std::shared_ptr<Connection>& conn) {
+        conn->busy = true;
+        bool queued = server_.worker_pool_->submit([loop = shared_from_this(), conn,
+                                                    async_producer = conn->async_producer]() {
+            std::string data;
+            bool more = false;
+            try {
+                if (async_producer) {
+                    (*async_producer)([loop, conn](std::string piece, bool more) {
+                        loop->deliver_chunk(conn, piece, more, false);
+                    });
+                    return;
+                }
+                more = conn->producer(data);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Response stream failed: {}", e.what());
+                loop->deliver_chunk(conn, {}, false, true);
+                return;
+            }
+            loop->deliver_chunk(conn, data, more, false);
+        });
+        if (!queued) {
+            conn->busy = false;
+            close_connection(conn);
+        }
+    }
+    
+    // Hands a produced piece to the I/O thread as the next chunk
+    void deliver_chunk(const std::shared_ptr<Connection>& conn, std::string_view data, bool more, bool failed) {
+        std::string framed;
+        append_chunk(framed, data, !more);
+        post([this, conn, framed = std::move(framed), more, failed]() mutable {
+            conn->busy = false;
+            if (conn->fd < 0) return;
+            if (failed) {
+                // Headers are out; an unterminated body is the only error signal left
+                close_connection(conn);
+                return;
+            }
+            conn->body = std::move(framed);
+            conn->stream_done = !more;
+            conn->progressed = true;
+            flush(conn);
+            update_deadline(conn);
+        });
+    }
+    
+    void close_file(const std::shared_ptr<Connection>& conn) {
+        if (conn->file_fd >= 0) {
+            close(conn->file_fd);
+            conn->file_fd = -1;
+        }
+    }
+    
+    void close_connection(const std::shared_ptr<Connection>& conn) {
+        wheel_.cancel(conn->deadline);
+        close_file(conn);
+        conn->closed = true;
+        if (conn->fd < 0) return;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, conn->fd, nullptr);
+        CLOSE_SOCKET(conn->fd);
+        connections_.erase(conn->fd);
+        conn->fd = -1;
+    }
+};
+
+#else
+
+// Placeholders so the unique_ptr members compile on platforms without epoll
+struct HttpServer::Connection {};
+class HttpServer::EventLoop : public std::enable_shared_from_this<HttpServer::EventLoop> {
+public:
+    std::thread thread;
+};
+
+#endif // SEC_ANALYZER_HAS_EPOLL
+
+socket_t HttpServer::open_listener(bool reuse_port) {
+    socket_t sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock == INVALID_SOCKET_VALUE) {
         LOG_ERROR("Failed to create socket");
-        return false;
+        return INVALID_SOCKET_VALUE;
     }
     
     // Allow address reuse
     int opt = 1;
 #ifdef _WIN32
-    setsockopt(server_socket_, SOL_SOCKET, SO_REUSEADDR, (const char*)&opt, sizeof(opt));
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, (const char*)&opt, sizeof(opt));
 #else
-    setsockopt(server_socket_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+#endif
+    
+#ifdef SO_REUSEPORT
+    // Every listener in the group needs the option before bind()
+    if (reuse_port && setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+        LOG_ERROR("Failed to enable SO_REUSEPORT: {}", std::strerror(errno));
+        CLOSE_SOCKET(sock);
+        return INVALID_SOCKET_VALUE;
+    }
 #endif
     
     sockaddr_in addr{};
@@ -80,40 +1044,183 @@ bool HttpServer::start() {
     addr.sin_addr.s_addr = INADDR_ANY;
     addr.sin_port = htons(static_cast<uint16_t>(port_));
     
-    if (bind(server_socket_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+    if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
         LOG_ERROR("Failed to bind to port {}", port_);
-        CLOSE_SOCKET(server_socket_);
-        return false;
+        CLOSE_SOCKET(sock);
+        return INVALID_SOCKET_VALUE;
     }
     
-    if (listen(server_socket_, SOMAXCONN) < 0) {
+    if (listen(sock, SOMAXCONN) < 0) {
         LOG_ERROR("Failed to listen on socket");
-        CLOSE_SOCKET(server_socket_);
+        CLOSE_SOCKET(sock);
+        return INVALID_SOCKET_VALUE;
+    }
+    return sock;
+}
+
+bool HttpServer::start() {
+#ifndef SEC_ANALYZER_HAS_EPOLL
+    if (io_mode_ == IoMode::EVENT_LOOP) {
+        LOG_WARNING("Event loop not available on this platform, using blocking I/O");
+        io_mode_ = IoMode::BLOCKING;
+    }
+#endif
+    
+#ifdef SO_REUSEPORT
+    bool reuse_port = reuse_port_ && io_mode_ == IoMode::EVENT_LOOP;
+#else
+    bool reuse_port = false;
+#endif
+    if (reuse_port_ && !reuse_port) {
+        LOG_WARNING("SO_REUSEPORT listeners need the event loop on Linux, using one listener");
+    }
+    
+    server_socket_ = open_listener(reuse_port);
+    if (server_socket_ == INVALID_SOCKET_VALUE) {
         return false;
     }
     
+    // One more listener per additional event loop; the kernel hashes new
+    // connections across the group so no loop hands sockets to another
+    for (int i = 1; reuse_port && i < io_threads_; ++i) {
+        socket_t sock = open_listener(true);
+        if (sock == INVALID_SOCKET_VALUE) {
+            close_listeners();
+            return false;
+        }
+        extra_listeners_.push_back(sock);
+    }
+    reuse_port_active_ = reuse_port;
+    
     running_ = true;
     
+    worker_pool_ = std::make_unique<ThreadPool>(static_cast<size_t>(thread_count_), queue_capacity_);
+    worker_pool_->start();
+    
+    static_assets_ = std::make_unique<StaticAssetCache>(static_dir_);
+    static_assets_->start();
+    LOG_INFO("Static asset cache loaded {} file(s) from {}", static_assets_->size(), static_dir_);
+    
+    if (io_mode_ == IoMode::EVENT_LOOP) {
+        if (!start_event_loops()) {
+            running_ = false;
+            worker_pool_->shutdown();
+            worker_pool_.reset();
+            static_assets_->stop();
+            close_listeners();
+            return false;
+        }
+        LOG_INFO("HTTP server using {} event loop thread(s){}{}, {} worker(s)", io_threads_,
+                 reuse_port_active_ ? " with SO_REUSEPORT listeners" : "",
+                 pin_io_threads_ ? ", pinned" : "", worker_pool_->thread_count());
+        return true;
+    }
+    
     // Start accept thread
-    worker_threads_.emplace_back(&HttpServer::accept_connections, this);
+    LOG_INFO("HTTP server using blocking I/O, {} worker(s)", worker_pool_->thread_count());
+    accept_threads_.emplace_back(&HttpServer::accept_connections, this);
     
     return true;
 }
 
-void HttpServer::stop() {
-    running_ = false;
-    
+void HttpServer::close_listeners() {
     if (server_socket_ != INVALID_SOCKET_VALUE) {
+#ifndef _WIN32
+        // Wakes a blocking accept() in the fallback accept thread
+        shutdown(server_socket_, SHUT_RDWR);
+#endif
         CLOSE_SOCKET(server_socket_);
         server_socket_ = INVALID_SOCKET_VALUE;
     }
+    for (socket_t sock : extra_listeners_) {
+        CLOSE_SOCKET(sock);
+    }
+    extra_listeners_.clear();
+}
+
+ThreadPoolStats HttpServer::get_worker_stats() const {
+    return worker_pool_ ? worker_pool_->stats() : ThreadPoolStats{};
+}
+
+bool HttpServer::start_event_loops() {
+#ifdef SEC_ANALYZER_HAS_EPOLL
+    // Loop 0 owns the shared listener, or with SO_REUSEPORT each loop owns one
+    std::vector<int> listeners(static_cast<size_t>(io_threads_), -1);
+    listeners[0] = server_socket_;
+    for (size_t i = 0; i < extra_listeners_.size(); ++i) {
+        listeners[i + 1] = extra_listeners_[i];
+    }
+    
+    for (int fd : listeners) {
+        if (fd >= 0 && !set_non_blocking(fd)) {
+            LOG_ERROR("Failed to make listening socket non-blocking");
+            return false;
+        }
+    }
+    
+    for (int fd : listeners) {
+        auto loop = std::make_shared<EventLoop>(*this, fd);
+        if (!loop->init()) {
+            LOG_ERROR("Failed to initialize event loop: {}", std::strerror(errno));
+            event_loops_.clear();
+            return false;
+        }
+        event_loops_.push_back(std::move(loop));
+    }
+    
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t i = 0; i < event_loops_.size(); ++i) {
+        auto& loop = event_loops_[i];
+        loop->thread = std::thread(&EventLoop::run, loop.get());
+        if (pin_io_threads_) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(i % cores, &cpus);
+            int rc = pthread_setaffinity_np(loop->thread.native_handle(), sizeof(cpus), &cpus);
+            if (rc != 0) {
+                LOG_WARNING("Failed to pin event loop {} to CPU {}: {}", i, i % cores, std::strerror(rc));
+            }
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void HttpServer::stop() {
+    running_ = false;
+    
+#ifdef SEC_ANALYZER_HAS_EPOLL
+    for (auto& loop : event_loops_) {
+        loop->wake();
+    }
+#endif
+    for (auto& loop : event_loops_) {
+        if (loop->thread.joinable()) {
+            loop->thread.join();
+        }
+    }
     
-    for (auto& thread : worker_threads_) {
+    close_listeners();
+    
+    for (auto& thread : accept_threads_) {
         if (thread.joinable()) {
             thread.join();
         }
     }
-    worker_threads_.clear();
+    accept_threads_.clear();
+    
+    // Workers may still post results to the loops, so drain them first
+    if (worker_pool_) {
+        worker_pool_->shutdown();
+    }
+    event_loops_.clear();
+    worker_pool_.reset();
+    
+    if (static_assets_) {
+        static_assets_->stop();
+    }
 }
 
 void HttpServer::accept_connections() {
@@ -136,231 +1243,556 @@ void HttpServer::accept_connections() {
         inet_ntop(AF_INET, &client_addr.sin_addr, ip_str, INET_ADDRSTRLEN);
         std::string client_ip = ip_str;
         
-        // Handle client in new thread
-        std::thread([this, client_socket, client_ip]() {
-            handle_client(client_socket, client_ip);
-        }).detach();
+        // Handle client on the bounded worker pool
+        auto queued_at = std::chrono::steady_clock::now();
+        bool queued = worker_pool_->submit([this, client_socket, client_ip, queued_at]() {
+            handle_client(client_socket, client_ip, std::chrono::steady_clock::now() - queued_at);
+        });
+        if (!queued) {
+            LOG_WARNING("Worker queue full, rejecting connection from {}", client_ip);
+            HttpResponse busy = overloaded_response();
+            std::string head;
+            render_head(busy, false, head);
+            send_response(client_socket, head, busy.body);
+            CLOSE_SOCKET(client_socket);
+        }
     }
 }
 
-void HttpServer::handle_client(socket_t client_socket, const std::string& client_ip) {
+void HttpServer::handle_client(socket_t client_socket, const std::string& client_ip,
+                               std::chrono::steady_clock::duration queue_delay) {
     // Read request
     std::string raw_request;
-    char buffer[4096];
-    int bytes_read;
+    char buffer[8192];
+    HttpRequestParser parser;
+    parser.set_max_body_size(max_body_size_);
+    auto status = HttpRequestParser::Status::INCOMPLETE;
+    bool continue_sent = false;
     
-    while ((bytes_read = recv(client_socket, buffer, sizeof(buffer) - 1, 0)) > 0) {
-        buffer[bytes_read] = '\0';
-        raw_request += buffer;
-        
-        // Check if we have complete headers
-        if (raw_request.find("\r\n\r\n") != std::string::npos) {
+    // Kernel timeouts bound each recv/send; the header deadline is checked
+    // across reads so a client trickling bytes cannot hold the thread
+    set_socket_timeout(client_socket, SO_RCVTIMEO, std::max(1, header_timeout_seconds_));
+    set_socket_timeout(client_socket, SO_SNDTIMEO, std::max(1, write_timeout_seconds_));
+    auto header_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(std::max(1, header_timeout_seconds_));
+    bool reading_body = false;
+    bool timed_out = false;
+    
+    while (status == HttpRequestParser::Status::INCOMPLETE) {
+        int bytes_read = recv(client_socket, buffer, sizeof(buffer), 0);
+        if (bytes_read <= 0) {
+            timed_out = bytes_read < 0 && !raw_request.empty();
             break;
         }
+        raw_request.append(buffer, static_cast<size_t>(bytes_read));
+        status = parser.parse(raw_request);
+        if (status == HttpRequestParser::Status::INCOMPLETE && !reading_body) {
+            if (parser.awaiting_body()) {
+                reading_body = true;
+                set_socket_timeout(client_socket, SO_RCVTIMEO, std::max(1, body_timeout_seconds_));
+            } else if (std::chrono::steady_clock::now() > header_deadline) {
+                timed_out = true;
+                break;
+            }
+        }
+        if (status == HttpRequestParser::Status::INCOMPLETE && !continue_sent &&
+            parser.awaiting_body() && parser.expects_continue()) {
+            continue_sent = true;
+            send(client_socket, CONTINUE_RESPONSE, static_cast<int>(sizeof(CONTINUE_RESPONSE) - 1), 0);
+        }
     }
     
-    if (raw_request.empty()) {
-        CLOSE_SOCKET(client_socket);
-        return;
-    }
-    
-    // Parse request
-    HttpRequest request = parse_request(raw_request);
-    request.client_ip = client_ip;
-    
-    LOG_DEBUG("{} {} from {}", request.method, request.path, client_ip);
-    
-    // Handle CORS preflight
-    if (cors_enabled_ && request.method == "OPTIONS") {
-        HttpResponse response(204, "No Content");
-        add_cors_headers(response);
-        std::string raw_response = serialize_response(response);
-        send(client_socket, raw_response.c_str(), static_cast<int>(raw_response.length()), 0);
+    if (status == HttpRequestParser::Status::INCOMPLETE) {
+        if (timed_out) {
+            HttpResponse timeout = HttpResponse::error(408, "Request Timeout");
+            std::string head;
+            render_head(timeout, false, head);
+            send_response(client_socket, head, timeout.body);
+        }
         CLOSE_SOCKET(client_socket);
         return;
     }
     
-    // Find handler
+    // Send response; the blocking path serves one request per connection
+    // and simply waits for a deferred response on this thread
+    bool keep_alive = false;
     HttpResponse response;
-    bool found = false;
+    if (status == HttpRequestParser::Status::COMPLETE) {
+        std::promise<HttpResponse> ready;
+        std::future<HttpResponse> result = ready.get_future();
+        process_request(raw_request, parser.layout(), client_ip, false, queue_delay,
+            [&ready](HttpResponse res, bool) { ready.set_value(std::move(res)); });
+        response = result.get();
+    } else {
+        response = HttpResponse::error(parser.error_status(), parser.error_message());
+    }
     
-    {
-        std::lock_guard<std::mutex> lock(handlers_mutex_);
-        auto it = handlers_.find({request.method, request.path});
-        if (it != handlers_.end()) {
+    // Per worker thread, so the header buffer is allocated once
+    thread_local std::string head;
+    render_head(response, keep_alive, head);
+    std::string_view body = response.shared_body ? std::string_view(*response.shared_body)
+                                                 : std::string_view(response.body);
+    if (send_response(client_socket, head, body)) {
+        if (!response.file_path.empty()) {
+            send_file(client_socket, response.file_path, response.file_size,
+                      std::max(1, write_timeout_seconds_));
+        }
+        std::string data;
+        std::string framed;
+        bool more = static_cast<bool>(response.producer);
+        while (more) {
+            data.clear();
+            framed.clear();
             try {
-                response = it->second(request);
-                found = true;
+                more = response.producer(data);
             } catch (const std::exception& e) {
-                LOG_ERROR("Handler error: {}", e.what());
-                response = HttpResponse::internal_error(e.what());
-                found = true;
+                LOG_ERROR("Response stream failed: {}", e.what());
+                break;
+            }
+            append_chunk(framed, data, !more);
+            if (!send_response(client_socket, framed, {})) break;
+        }
+        
+        // This thread already waits out the whole exchange, so it waits for
+        // each async piece as it does for a deferred response
+        more = static_cast<bool>(response.async_producer);
+        while (more) {
+            auto ready = std::make_shared<std::promise<std::pair<std::string, bool>>>();
+            std::future<std::pair<std::string, bool>> piece = ready->get_future();
+            try {
+                response.async_producer([ready](std::string data, bool more) {
+                    ready->set_value({std::move(data), more});
+                });
+                std::tie(data, more) = piece.get();
+            } catch (const std::exception& e) {
+                LOG_ERROR("Response stream failed: {}", e.what());
+                break;
+            }
+            framed.clear();
+            append_chunk(framed, data, !more);
+            if (!send_response(client_socket, framed, {})) break;
+        }
+        
+        if (response.stream_writer) {
+            // Pushed stream: write each piece straight to the socket
+            class SocketSink : public ResponseSink {
+            public:
+                explicit SocketSink(socket_t sock) : sock_(sock) {}
+                bool write(std::string_view data) override {
+                    if (!open_ || data.empty()) return open_;
+                    framed_.clear();
+                    append_chunk(framed_, data, false);
+                    open_ = send_response(sock_, framed_, {});
+                    return open_;
+                }
+                bool open() const { return open_; }
+            private:
+                socket_t sock_;
+                std::string framed_;
+                bool open_ = true;
+            };
+            
+            SocketSink sink(client_socket);
+            try {
+                response.stream_writer(sink);
+                if (sink.open()) {
+                    std::string last;
+                    append_chunk(last, {}, true);
+                    send_response(client_socket, last, {});
+                }
+            } catch (const std::exception& e) {
+                LOG_ERROR("Response stream failed: {}", e.what());
             }
         }
     }
     
-    // Try static file serving
-    if (!found && request.method == "GET") {
-        response = serve_static_file(request.path);
-        found = true;
-    }
+    CLOSE_SOCKET(client_socket);
+}
+
+void HttpServer::process_request(std::string_view raw, const HttpRequestLayout& layout,
+                                 const std::string& client_ip, bool keep_alive,
+                                 std::chrono::steady_clock::duration queue_delay, RequestDone done) {
+    HttpRequestView request(raw, layout);
     
-    if (!found) {
-        response = HttpResponse::not_found();
+    LOG_DEBUG("{} {} from {}", request.method(), request.path(), client_ip);
+    
+    // HTTP/1.1 defaults to persistent connections, HTTP/1.0 must opt in
+    std::string_view connection = request.header("Connection");
+    bool http11 = request.version() == "HTTP/1.1";
+    if (http11) {
+        keep_alive = keep_alive && !util::iequals(connection, "close");
+    } else {
+        keep_alive = keep_alive && util::iequals(connection, "keep-alive");
     }
     
-    // Add CORS headers
+    // The request buffer may be gone by the time a deferred response arrives
+    dispatch(request, client_ip, queue_delay,
+        [this, http11, keep_alive, accept_encoding = std::string(request.header("Accept-Encoding")),
+         if_none_match = std::string(request.header("If-None-Match")),
+         done = std::move(done)](HttpResponse response) {
+        // HTTP/1.0 has no chunked encoding: an async stream is gathered into a
+        // plain body first, finishing on the thread that delivers its last piece
+        if (response.async_producer && !http11) {
+            auto producer = std::make_shared<AsyncBodyProducer>(std::move(response.async_producer));
+            response.async_producer = nullptr;
+            auto gathered = std::make_shared<HttpResponse>(std::move(response));
+            gather_body(gathered, producer, [this, gathered, keep_alive, accept_encoding, if_none_match, done]() {
+                finish_response(*gathered, false, accept_encoding, if_none_match);
+                done(std::move(*gathered), keep_alive);
+            });
+            return;
+        }
+        finish_response(response, http11, accept_encoding, if_none_match);
+        done(std::move(response), keep_alive);
+    });
+}
+
+void HttpServer::finish_response(HttpResponse& response, bool http11, std::string_view accept_encoding,
+                                 std::string_view if_none_match) {
     if (cors_enabled_) {
         add_cors_headers(response);
     }
     
-    // Send response
-    std::string raw_response = serialize_response(response);
-    send(client_socket, raw_response.c_str(), static_cast<int>(raw_response.length()), 0);
+    // HTTP/1.0 has no chunked encoding: drain the stream into a plain body
+    if ((response.producer || response.stream_writer) && !http11) {
+        try {
+            if (response.producer) {
+                while (response.producer(response.body)) {}
+            } else {
+                BufferSink sink(response.body);
+                response.stream_writer(sink);
+            }
+            response.producer = nullptr;
+            response.stream_writer = nullptr;
+        } catch (const std::exception& e) {
+            LOG_ERROR("Response stream failed: {}", e.what());
+            response = HttpResponse::internal_error(e.what());
+            if (cors_enabled_) {
+                add_cors_headers(response);
+            }
+        }
+    }
     
-    CLOSE_SOCKET(client_socket);
+    // Runs on the responding thread, so compression never blocks an I/O thread
+    compress_response(response, accept_encoding);
+    
+    // Checked last: the tag must name the representation actually chosen
+    if (response.status_code == 200 && !if_none_match.empty()) {
+        auto etag = response.headers.find("ETag");
+        if (etag != response.headers.end() && etag_matches(if_none_match, etag->second)) {
+            response.status_code = 304;
+            response.status_text = "Not Modified";
+            response.body.clear();
+            response.shared_body.reset();
+            response.file_path.clear();
+            response.file_size = 0;
+            response.producer = nullptr;
+            response.async_producer = nullptr;
+            response.stream_writer = nullptr;
+            response.headers.erase("Content-Type");
+            response.headers.erase("Content-Encoding");
+        }
+    }
 }
 
-HttpRequest HttpServer::parse_request(const std::string& raw) {
-    HttpRequest request;
-    std::istringstream stream(raw);
-    std::string line;
+void HttpServer::dispatch(const HttpRequestView& request, const std::string& client_ip,
+                          std::chrono::steady_clock::duration queue_delay, ResponseCallback respond) {
+    // Handle CORS preflight
+    if (cors_enabled_ && request.method() == "OPTIONS") {
+        respond(HttpResponse(204, "No Content"));
+        return;
+    }
+    
+    const RouteTable* routes = routes_.load(std::memory_order_acquire);
+    PathParams params;
+    RouteTable::Match match;
+    if (routes) {
+        match = routes->find(request.method(), request.path(), params);
+    }
     
-    // Parse request line
-    if (std::getline(stream, line)) {
-        // Remove \r if present
-        if (!line.empty() && line.back() == '\r') {
-            line.pop_back();
+    respond = [started = std::chrono::steady_clock::now() - queue_delay,
+               route = match.endpoint ? match.endpoint->front().second.pattern : std::string("unrouted"),
+               method = std::string(request.method()), respond = std::move(respond)](HttpResponse response) {
+        record_request(route, method, response.status_code, std::chrono::steady_clock::now() - started);
+        respond(std::move(response));
+    };
+    
+    if (match.value) {
+        HttpResponse refusal;
+        if (rate_limited(request, client_ip, refusal)) {
+            respond(std::move(refusal));
+            return;
         }
         
-        std::istringstream request_line(line);
-        std::string version;
-        request_line >> request.method >> request.path >> version;
+        // An admitted request holds its in-flight slot until it is answered
+        if (admission_) {
+            RequestPriority priority = RequestPriority::NORMAL;
+            if (!route_priorities_.empty()) {
+                auto it = route_priorities_.find(std::string(request.path()));
+                if (it != route_priorities_.end()) priority = it->second;
+            }
+            if (!admission_->admit(priority, queue_delay)) {
+                LOG_DEBUG("Shed {} {} from {}", request.method(), request.path(), client_ip);
+                respond(overloaded_response());
+                return;
+            }
+            respond = [admission = admission_, respond = std::move(respond)](HttpResponse response) {
+                admission->release();
+                respond(std::move(response));
+            };
+        }
         
-        // Parse query string
-        size_t query_pos = request.path.find('?');
-        if (query_pos != std::string::npos) {
-            request.query_string = request.path.substr(query_pos + 1);
-            request.path = request.path.substr(0, query_pos);
-            
-            // Parse query parameters
-            std::istringstream params_stream(request.query_string);
-            std::string param;
-            while (std::getline(params_stream, param, '&')) {
-                size_t eq_pos = param.find('=');
-                if (eq_pos != std::string::npos) {
-                    std::string key = util::url_decode(param.substr(0, eq_pos));
-                    std::string value = util::url_decode(param.substr(eq_pos + 1));
-                    request.params[key] = value;
-                }
+        // Owned strings are only built for requests a handler will see;
+        // path parameters take precedence over query parameters
+        HttpRequest owned = request.materialize(client_ip);
+        for (const auto& [name, value] : params) {
+            if (name.empty()) continue;     // Anonymous wildcard
+            owned.params[std::string(name)] = util::url_decode(std::string(value));
+        }
+        
+        const Route& route = *match.value;
+        if (!route.async_handler) {
+            HttpResponse response;
+            try {
+                response = route.handler(owned);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Handler error: {}", e.what());
+                response = HttpResponse::internal_error(e.what());
             }
+            respond(std::move(response));
+            return;
         }
+        
+        // The first response wins, whether it comes from the handler or the error path
+        auto deferred = std::make_shared<DeferredResponse>(std::move(respond));
+        ResponseCallback once = [deferred](HttpResponse response) {
+            deferred->complete(std::move(response));
+        };
+        try {
+            route.async_handler(owned, once);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Handler error: {}", e.what());
+            once(HttpResponse::internal_error(e.what()));
+        }
+        return;
     }
     
-    // Parse headers
-    while (std::getline(stream, line)) {
-        if (!line.empty() && line.back() == '\r') {
-            line.pop_back();
+    // The path exists but not for this method; GET still falls back to static files
+    if (match.endpoint && request.method() != "GET") {
+        HttpResponse response = HttpResponse::error(405, "Method Not Allowed");
+        std::string allow;
+        for (const auto& [method, route] : *match.endpoint) {
+            if (!allow.empty()) allow += ", ";
+            allow += method;
         }
-        if (line.empty()) break;
-        
-        size_t colon_pos = line.find(':');
-        if (colon_pos != std::string::npos) {
-            std::string key = util::trim(line.substr(0, colon_pos));
-            std::string value = util::trim(line.substr(colon_pos + 1));
-            request.headers[key] = value;
+        response.headers["Allow"] = allow;
+        respond(std::move(response));
+        return;
+    }
+    
+    // Try static file serving
+    if (request.method() == "GET") {
+        respond(serve_static_file(request));
+        return;
+    }
+    
+    respond(HttpResponse::not_found());
+}
+
+void HttpServer::compress_response(HttpResponse& response, std::string_view accept_encoding) {
+    if (compression_level_ <= 0 || response.body.size() < compression_min_size_) return;
+    if (response.status_code != 200 || response.headers.count("Content-Encoding")) return;
+    
+    auto type = response.headers.find("Content-Type");
+    if (type == response.headers.end() || !compression::is_compressible(type->second)) return;
+    
+    response.headers["Vary"] = "Accept-Encoding";
+    std::string_view coding = compression::negotiate(accept_encoding);
+    if (coding.empty()) return;
+    
+    // The key includes a content hash so a recomputed body never picks up a
+    // stale variant; a strong ETag already is one
+    auto etag = response.headers.find("ETag");
+    bool strong_etag = etag != response.headers.end() && etag->second.size() > 2 &&
+                       etag->second.front() == '"' && etag->second.back() == '"';
+    std::string variant_key;
+    std::string encoded;
+    bool cached = false;
+    if (compression_cache_ && !response.variant_cache_key.empty()) {
+        variant_key = response.variant_cache_key + ":" + std::string(coding) + ":" +
+                      (strong_etag ? etag->second : util::to_hex(util::fnv1a64(response.body)));
+        auto hit = compression_cache_->get(variant_key);
+        if (hit && hit->fresh) {
+            encoded = *hit->body;
+            cached = true;
+            ++compression_cache_hits_;
         }
     }
     
-    // Read body if Content-Length present
-    auto cl_it = request.headers.find("Content-Length");
-    if (cl_it != request.headers.end()) {
-        size_t content_length = std::stoul(cl_it->second);
-        std::string remaining;
-        while (std::getline(stream, line)) {
-            remaining += line + "\n";
+    if (!cached) {
+        if (!compression::encode(coding, response.body, encoded, compression_level_) ||
+            encoded.size() >= response.body.size()) {
+            return;
         }
-        request.body = remaining.substr(0, content_length);
+        if (!variant_key.empty()) {
+            compression_cache_->put(variant_key, encoded, {}, {}, compression_cache_ttl_);
+        }
+    }
+    
+    ++compressed_responses_;
+    compression_bytes_in_ += response.body.size();
+    compression_bytes_out_ += encoded.size();
+    response.body = std::move(encoded);
+    response.headers["Content-Encoding"] = std::string(coding);
+    
+    // A compressed body is a different representation, so it gets its own tag
+    if (strong_etag) {
+        etag->second.insert(etag->second.size() - 1, "-" + std::string(coding));
+    }
+}
+
+CompressionStats HttpServer::get_compression_stats() const {
+    CompressionStats stats;
+    stats.responses = compressed_responses_;
+    stats.bytes_in = compression_bytes_in_;
+    stats.bytes_out = compression_bytes_out_;
+    stats.variant_cache_hits = compression_cache_hits_;
+    if (compression_cache_) {
+        ResponseCacheStats variants = compression_cache_->stats();
+        stats.variant_cache_entries = variants.entries;
+        stats.variant_cache_bytes = variants.bytes;
     }
+    return stats;
+}
+
+RateLimiterStats HttpServer::get_rate_limit_stats() const {
+    return rate_limiter_ ? rate_limiter_->stats() : RateLimiterStats{};
+}
+
+AdmissionStats HttpServer::get_admission_stats() const {
+    return admission_ ? admission_->stats() : AdmissionStats{};
+}
+
+HttpResponse HttpServer::overloaded_response() const {
+    HttpResponse response = HttpResponse::error(503, "Service Unavailable");
+    response.headers["Retry-After"] = std::to_string(admission_ ? admission_->retry_after_seconds() : 1);
+    return response;
+}
+
+bool HttpServer::rate_limited(const HttpRequestView& request, const std::string& client_ip,
+                              HttpResponse& refusal) {
+    if (!rate_limiter_ || rate_limit_exempt_.count(std::string(request.path()))) return false;
     
-    return request;
+    RateLimitDecision decision;
+    std::string_view key = rate_limit_key_header_.empty()
+        ? std::string_view() : request.header(rate_limit_key_header_);
+    if (!key.empty() && rate_limit_keys_.count(std::string(key))) {
+        std::string client = "key:";
+        client.append(key);
+        decision = rate_limiter_->acquire(client);
+    } else {
+        decision = rate_limiter_->acquire(client_ip);
+    }
+    if (decision.allowed) return false;
+    
+    LOG_DEBUG("Rate limited {} {} from {}", request.method(), request.path(), client_ip);
+    refusal = HttpResponse::error(429, "Too Many Requests");
+    refusal.headers["Retry-After"] = std::to_string(decision.retry_after_seconds);
+    return true;
 }
 
-std::string HttpServer::serialize_response(const HttpResponse& response) {
-    std::ostringstream oss;
+void HttpServer::render_head(const HttpResponse& response, bool keep_alive, std::string& head) const {
+    head.clear();
     
-    oss << "HTTP/1.1 " << response.status_code << " " << response.status_text << "\r\n";
+    head.append("HTTP/1.1 ");
+    append_number(head, response.status_code);
+    head.append(" ").append(response.status_text).append("\r\n");
     
     // Add standard headers
-    oss << "Server: SECFraudAnalyzer/2.1.2\r\n";
-    oss << "Connection: close\r\n";
+    head.append("Server: SECFraudAnalyzer/2.1.2\r\n");
+    if (keep_alive) {
+        head.append("Connection: keep-alive\r\nKeep-Alive: timeout=");
+        append_number(head, keep_alive_timeout_seconds_);
+        head.append("\r\n");
+    } else {
+        head.append("Connection: close\r\n");
+    }
     
-    // Add content length
-    oss << "Content-Length: " << response.body.length() << "\r\n";
+    // Add content length (204 and 304 never carry a body)
+    if (response.producer || response.async_producer || response.stream_writer) {
+        head.append("Transfer-Encoding: chunked\r\n");
+    } else if (response.status_code != 204 && response.status_code != 304) {
+        head.append("Content-Length: ");
+        append_number(head, static_cast<long long>(response.content_length()));
+        head.append("\r\n");
+    }
     
     // Add custom headers
     for (const auto& [key, value] : response.headers) {
-        oss << key << ": " << value << "\r\n";
+        head.append(key).append(": ").append(value).append("\r\n");
     }
     
-    oss << "\r\n";
-    oss << response.body;
-    
-    return oss.str();
+    head.append("\r\n");
 }
 
-HttpResponse HttpServer::serve_static_file(const std::string& path) {
-    std::string file_path = static_dir_ + (path == "/" ? "/index.html" : path);
+HttpResponse HttpServer::serve_static_file(const HttpRequestView& request) {
+    std::string path(request.path());
+    if (path == "/") path = "/index.html";
     
     // Security: prevent directory traversal
-    if (file_path.find("..") != std::string::npos) {
+    if (path.find("..") != std::string::npos) {
         return HttpResponse::error(403, "Forbidden");
     }
     
-    std::ifstream file(file_path, std::ios::binary);
-    if (!file.is_open()) {
-        return HttpResponse::not_found();
+    std::shared_ptr<const StaticAsset> asset = static_assets_ ? static_assets_->find(path) : nullptr;
+    if (!asset) {
+        // Not indexed (yet): stream straight from disk
+        std::string file_path = static_dir_ + path;
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(file_path, ec)) {
+            return HttpResponse::not_found();
+        }
+        HttpResponse response(200, "OK");
+        response.file_size = static_cast<size_t>(std::filesystem::file_size(file_path, ec));
+        response.file_path = std::move(file_path);
+        response.headers["Content-Type"] = StaticAssetCache::mime_type(path);
+        return response;
     }
     
-    std::ostringstream oss;
-    oss << file.rdbuf();
+    // The gzip variant is a different representation, so it gets its own tag
+    bool use_gzip = asset->gzip_body && compression::accepts(request.header("Accept-Encoding"), "gzip");
+    std::string etag = use_gzip ? asset->etag.substr(0, asset->etag.size() - 1) + "-gz\"" : asset->etag;
     
-    HttpResponse response = HttpResponse::ok(oss.str(), get_mime_type(file_path));
-    return response;
-}
-
-std::string HttpServer::get_mime_type(const std::string& path) {
-    std::string ext = util::get_extension(path);
-    
-    static const std::map<std::string, std::string> mime_types = {
-        {"html", "text/html; charset=utf-8"},
-        {"htm", "text/html; charset=utf-8"},
-        {"css", "text/css; charset=utf-8"},
-        {"js", "application/javascript; charset=utf-8"},
-        {"json", "application/json; charset=utf-8"},
-        {"png", "image/png"},
-        {"jpg", "image/jpeg"},
-        {"jpeg", "image/jpeg"},
-        {"gif", "image/gif"},
-        {"svg", "image/svg+xml"},
-        {"ico", "image/x-icon"},
-        {"txt", "text/plain; charset=utf-8"},
-        {"xml", "application/xml"},
-        {"pdf", "application/pdf"},
-        {"csv", "text/csv"},
-        {"woff", "font/woff"},
-        {"woff2", "font/woff2"},
-        {"ttf", "font/ttf"},
-    };
+    HttpResponse response(200, "OK");
+    response.headers["ETag"] = etag;
+    response.headers["Cache-Control"] = "no-cache";
+    if (asset->gzip_body) {
+        response.headers["Vary"] = "Accept-Encoding";
+    }
+    
+    if (etag_matches(request.header("If-None-Match"), etag)) {
+        response.status_code = 304;
+        response.status_text = "Not Modified";
+        return response;
+    }
     
-    auto it = mime_types.find(ext);
-    return (it != mime_types.end()) ? it->second : "application/octet-stream";
+    response.headers["Content-Type"] = asset->content_type;
+    if (use_gzip) {
+        response.headers["Content-Encoding"] = "gzip";
+        response.shared_body = asset->gzip_body;
+    } else if (asset->body) {
+        response.shared_body = asset->body;
+    } else {
+        response.file_path = asset->file_path;
+        response.file_size = asset->size;
+    }
+    return response;
 }
 
 void HttpServer::add_cors_headers(HttpResponse& response) {
     response.headers["Access-Control-Allow-Origin"] = "*";
     response.headers["Access-Control-Allow-Methods"] = "GET, POST, PUT, DELETE, OPTIONS";
-    response.headers["Access-Control-Allow-Headers"] = "Content-Type, Authorization";
+    response.headers["Access-Control-Allow-Headers"] = rate_limit_key_header_.empty()
+        ? "Content-Type, Authorization" : "Content-Type, Authorization, " + rate_limit_key_header_;
     response.headers["Access-Control-Max-Age"] = "86400";
 }
 
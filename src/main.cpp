@@ -15,6 +15,8 @@
 #include <sec_analyzer/json.h>
 #include <sec_analyzer/util.h>
 #include <sec_analyzer/cache.h>
+#include <sec_analyzer/single_flight.h>
+#include <sec_analyzer/metrics.h>
 #include <sec_analyzer/http_server.h>
 #include <sec_analyzer/sec_fetcher.h>
 #include <sec_analyzer/analyzer.h>
@@ -23,8 +25,11 @@
 #include <iostream>
 #include <string>
 #include <memory>
+#include <algorithm>
 #include <csignal>
 #include <atomic>
+#include <mutex>
+#include <unordered_map>
 #include <fstream>
 
 using namespace sec_analyzer;
@@ -66,6 +71,10 @@ void print_usage(const char* program) {
     std::cout << "  --log-file <file>   Write logs to file (in addition to console)\n";
     std::cout << "  --verbose           Enable verbose logging (same as --log-level debug)\n";
     std::cout << "  --quiet             Suppress console output (errors only)\n";
+    std::cout << "  --threads <count>   Request worker threads (default: 4)\n";
+    std::cout << "  --blocking-io       Use thread-per-connection I/O (debugging)\n";
+    std::cout << "  --io-threads <n>    Event loop threads (default: 2)\n";
+    std::cout << "  --reuse-port        One SO_REUSEPORT listener per event loop (Linux)\n";
     std::cout << "  --version           Show version information\n";
     std::cout << "  --help              Show this help message\n";
     std::cout << "\n";
@@ -116,12 +125,50 @@ bool load_config(ServerConfig& config, const std::string& path) {
         if (json.contains("user_agent")) {
             config.sec_user_agent = json.at("user_agent").as_string();
         }
+        if (json.contains("sec_base_url")) {
+            config.sec_base_url = json.at("sec_base_url").as_string();
+        }
+        if (json.contains("directory_refresh")) {
+            config.directory_refresh_seconds = json.at("directory_refresh").as_int();
+        }
+        if (json.contains("sec_cache")) {
+            auto& c = json.at("sec_cache");
+            if (c.contains("max_mb")) config.sec_cache.max_mb = c.at("max_mb").as_int();
+            if (c.contains("tickers_ttl")) config.sec_cache.tickers_ttl = c.at("tickers_ttl").as_int();
+            if (c.contains("submissions_ttl")) config.sec_cache.submissions_ttl = c.at("submissions_ttl").as_int();
+            if (c.contains("company_facts_ttl")) config.sec_cache.company_facts_ttl = c.at("company_facts_ttl").as_int();
+            if (c.contains("documents_ttl")) config.sec_cache.documents_ttl = c.at("documents_ttl").as_int();
+        }
         if (json.contains("cache_ttl")) {
             config.cache_ttl_seconds = json.at("cache_ttl").as_int();
         }
         if (json.contains("rate_limit")) {
             config.rate_limit_per_minute = json.at("rate_limit").as_int();
         }
+        if (json.contains("rate_limit_burst")) {
+            config.rate_limit_burst = json.at("rate_limit_burst").as_int();
+        }
+        if (json.contains("rate_limit_key_header")) {
+            config.rate_limit_key_header = json.at("rate_limit_key_header").as_string();
+        }
+        if (json.contains("rate_limit_keys")) {
+            config.rate_limit_keys.clear();
+            for (const auto& key : json.at("rate_limit_keys").as_array()) {
+                config.rate_limit_keys.push_back(key.as_string());
+            }
+        }
+        if (json.contains("max_in_flight")) {
+            config.max_in_flight = json.at("max_in_flight").as_int();
+        }
+        if (json.contains("queue_target_ms")) {
+            config.queue_target_ms = json.at("queue_target_ms").as_int();
+        }
+        if (json.contains("queue_interval_ms")) {
+            config.queue_interval_ms = json.at("queue_interval_ms").as_int();
+        }
+        if (json.contains("overload_retry_after")) {
+            config.overload_retry_after = json.at("overload_retry_after").as_int();
+        }
         if (json.contains("verbose")) {
             config.verbose_logging = json.at("verbose").as_bool();
         }
@@ -134,6 +181,57 @@ bool load_config(ServerConfig& config, const std::string& path) {
         if (json.contains("cors")) {
             config.enable_cors = json.at("cors").as_bool();
         }
+        if (json.contains("thread_count")) {
+            config.thread_count = json.at("thread_count").as_int();
+        }
+        if (json.contains("worker_queue_size")) {
+            config.worker_queue_size = json.at("worker_queue_size").as_int();
+        }
+        if (json.contains("analysis_threads")) {
+            config.analysis_threads = json.at("analysis_threads").as_int();
+        }
+        if (json.contains("analysis_queue_size")) {
+            config.analysis_queue_size = json.at("analysis_queue_size").as_int();
+        }
+        if (json.contains("keep_alive_timeout")) {
+            config.keep_alive_timeout_seconds = json.at("keep_alive_timeout").as_int();
+        }
+        if (json.contains("max_requests_per_connection")) {
+            config.max_requests_per_connection = json.at("max_requests_per_connection").as_int();
+        }
+        if (json.contains("header_timeout")) {
+            config.header_timeout_seconds = json.at("header_timeout").as_int();
+        }
+        if (json.contains("body_timeout")) {
+            config.body_timeout_seconds = json.at("body_timeout").as_int();
+        }
+        if (json.contains("write_timeout")) {
+            config.write_timeout_seconds = json.at("write_timeout").as_int();
+        }
+        if (json.contains("max_body_size_kb")) {
+            config.max_body_size_kb = json.at("max_body_size_kb").as_int();
+        }
+        if (json.contains("compression_level")) {
+            config.compression_level = json.at("compression_level").as_int();
+        }
+        if (json.contains("compression_min_size")) {
+            config.compression_min_size = json.at("compression_min_size").as_int();
+        }
+        if (json.contains("compression_cache_mb")) {
+            config.compression_cache_mb = json.at("compression_cache_mb").as_int();
+        }
+        if (json.contains("io_threads")) {
+            config.io_threads = json.at("io_threads").as_int();
+        }
+        if (json.contains("blocking_io")) {
+            config.blocking_io = json.at("blocking_io").as_bool();
+        }
+        if (json.contains("reuse_port")) {
+            config.reuse_port = json.at("reuse_port").as_bool();
+        }
+        if (json.contains("pin_io_threads")) {
+            config.pin_io_threads = json.at("pin_io_threads").as_bool();
+        }
         
         // Load weights if present
         if (json.contains("weights")) {
@@ -178,9 +276,9 @@ int run_cli_analysis(const std::string& ticker, const std::string& cik,
         return 1;
     }
     
-    if (analyzer.has_error()) {
-        LOG_ERROR("Analysis failed: {}", analyzer.get_last_error());
-        std::cerr << "Error: " << analyzer.get_last_error() << "\n";
+    if (!result.error.empty()) {
+        LOG_ERROR("Analysis failed: {}", result.error);
+        std::cerr << "Error: " << result.error << "\n";
         return 1;
     }
     
@@ -199,9 +297,313 @@ int run_cli_analysis(const std::string& ticker, const std::string& cik,
 }
 
 // Setup API routes
+// Companies for an export request: ?tickers=A,B,C or a single ?ticker=A
+std::vector<std::string> export_tickers(const HttpRequest& req) {
+    std::vector<std::string> tickers;
+    for (const auto& part : util::split(req.get_param("tickers", req.get_param("ticker")), ',')) {
+        std::string ticker = util::trim(part);
+        if (!ticker.empty()) {
+            tickers.push_back(ticker);
+        }
+    }
+    return tickers;
+}
+
+constexpr size_t MAX_EXPORT_COMPANIES = 100;
+
+// Strong validator for a cached payload, stored alongside it
+std::string content_etag(const std::string& body) {
+    return util::quoted_etag(util::to_hex(util::fnv1a64(body)));
+}
+
+// Analysis JSON with its validator; clients may reuse it until the cache entry expires
+HttpResponse analysis_response(const std::string& json, const std::string& etag, int max_age,
+                               const std::string& cache_key) {
+    HttpResponse res = HttpResponse::ok(json);
+    res.variant_cache_key = cache_key;
+    if (!etag.empty()) {
+        res.headers["ETag"] = etag;
+    }
+    res.headers["Cache-Control"] = "max-age=" + std::to_string(max_age);
+    return res;
+}
+
+// cache_requests_total{cache="analysis"} child for a hit or a miss
+Counter& analysis_cache_counter(bool hit) {
+    static auto& family = MetricsRegistry::instance().counter("cache_requests_total",
+        "Cache lookups by cache and result", {"cache", "result"});
+    static Counter& hits = family.with({"analysis", "hit"});
+    static Counter& misses = family.with({"analysis", "miss"});
+    return hit ? hits : misses;
+}
+
+// A finished analysis: the result for exporters, its JSON for /api/analyze.
+// The cache tag holds the JSON's ETag.
+struct CachedAnalysis {
+    std::shared_ptr<const AnalysisResult> result;
+    std::string json;
+};
+using AnalysisCache = Cache<CachedAnalysis>;
+
+// How a request for an analysis ended
+struct AnalysisOutcome {
+    std::shared_ptr<const AnalysisResult> result;   // Null if the analysis failed or was shed
+    std::string json;
+    std::string etag;
+    int max_age = 0;                                // Seconds the cached copy stays valid
+    std::string error;
+    bool shed = false;                              // Refused under load; answer with overloaded_response()
+};
+
+/**
+ * Lands an analysis flight exactly once. The task calls land() with its
+ * outcome; if it throws first, or the executor drops it unrun at
+ * shutdown, the destructor lands the flight as shed so joined requests
+ * are answered instead of waiting on a flight that never ends.
+ * Shared because executor tasks must be copyable.
+ */
+class FlightLanding {
+public:
+    FlightLanding(std::shared_ptr<SingleFlight<AnalysisOutcome>> flights, std::string key)
+        : flights_(std::move(flights)), key_(std::move(key)) {}
+    
+    FlightLanding(const FlightLanding&) = delete;
+    FlightLanding& operator=(const FlightLanding&) = delete;
+    
+    ~FlightLanding() {
+        if (!landed_.exchange(true)) {
+            AnalysisOutcome dropped;
+            dropped.shed = true;
+            flights_->finish(key_, dropped);
+        }
+    }
+    
+    void land(const AnalysisOutcome& outcome) {
+        if (!landed_.exchange(true)) {
+            flights_->finish(key_, outcome);
+        }
+    }
+    
+private:
+    std::shared_ptr<SingleFlight<AnalysisOutcome>> flights_;
+    std::string key_;
+    std::atomic<bool> landed_{false};
+};
+
+/**
+ * Progress listeners of everyone waiting on a run, by cache key. The run
+ * reports each step once and every request attached to it hears about it,
+ * whether it started the run or joined it later.
+ */
+class ProgressBoard {
+public:
+    size_t watch(const std::string& key, ProgressCallback listener) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t id = next_id_++;
+        listeners_[key].emplace_back(id, std::move(listener));
+        return id;
+    }
+    
+    void unwatch(const std::string& key, size_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = listeners_.find(key);
+        if (it == listeners_.end()) return;
+        auto& list = it->second;
+        list.erase(std::remove_if(list.begin(), list.end(), [id](const auto& entry) { return entry.first == id; }),
+                   list.end());
+        if (list.empty()) listeners_.erase(it);
+    }
+    
+    // Called on the run's thread; listeners are called outside the lock
+    void report(const std::string& key, const AnalysisProgress& step) {
+        std::vector<ProgressCallback> targets;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = listeners_.find(key);
+            if (it == listeners_.end()) return;
+            for (const auto& entry : it->second) targets.push_back(entry.second);
+        }
+        for (const auto& listener : targets) listener(step);
+    }
+    
+private:
+    std::mutex mutex_;
+    size_t next_id_ = 0;
+    std::unordered_map<std::string, std::vector<std::pair<size_t, ProgressCallback>>> listeners_;
+};
+
+/**
+ * The one way routes obtain an analysis: the cache first, then a run
+ * already in flight for the same key, then a new run on the analysis
+ * executor. New runs are the first work shed under load (BULK).
+ */
+class AnalysisService {
+public:
+    using Callback = std::function<void(const AnalysisOutcome&)>;
+    
+    AnalysisService(HttpServer& server, std::shared_ptr<FraudAnalyzer> analyzer,
+                    std::shared_ptr<AnalysisCache> cache, std::shared_ptr<ThreadPool> pool)
+        : server_(server), analyzer_(std::move(analyzer)), cache_(std::move(cache)), pool_(std::move(pool)),
+          flights_(std::make_shared<SingleFlight<AnalysisOutcome>>()),
+          progress_(std::make_shared<ProgressBoard>()) {}
+    
+    static std::string cache_key(const std::string& ticker, const std::string& cik, int years) {
+        return "analysis:" + (ticker.empty() ? cik : ticker) + ":" + std::to_string(years);
+    }
+    
+    /**
+     * Calls done exactly once: on this thread for a cache hit or a shed
+     * request, otherwise on the executor thread that ran the analysis.
+     * on_progress, if given, hears the steps of the run this request ends
+     * up attached to from then on, always before done. Pass an empty
+     * ticker to analyze by CIK.
+     */
+    void analyze(const std::string& ticker, const std::string& cik, int years, Callback done,
+                 ProgressCallback on_progress = nullptr) {
+        std::string key = cache_key(ticker, cik, years);
+        auto cached = cache_->lookup(key);
+        analysis_cache_counter(cached.has_value()).inc();
+        if (cached) {
+            LOG_DEBUG("Cache hit for {}", key);
+            done(outcome_of(cached->value, cached->tag, cached->ttl_remaining));
+            return;
+        }
+        
+        if (on_progress) {
+            size_t id = progress_->watch(key, std::move(on_progress));
+            done = [progress = progress_, key, id, done = std::move(done)](const AnalysisOutcome& outcome) {
+                progress->unwatch(key, id);
+                done(outcome);
+            };
+        }
+        
+        // The same analysis already running: just wait for its result
+        if (!flights_->join(key, std::move(done))) {
+            LOG_DEBUG("Joined in-flight analysis for {}", key);
+            return;
+        }
+        
+        if (server_.overloaded(RequestPriority::BULK)) {
+            AnalysisOutcome shed;
+            shed.shed = true;
+            flights_->finish(key, shed);
+            return;
+        }
+        
+        auto landing = std::make_shared<FlightLanding>(flights_, key);
+        bool queued = pool_->submit([analyzer = analyzer_, cache = cache_, progress = progress_, landing,
+                                     ticker, cik, years, key]() {
+            auto report = [&progress, &key](const AnalysisProgress& step) { progress->report(key, step); };
+            AnalysisOutcome outcome;
+            try {
+                AnalysisResult result = ticker.empty() ? analyzer->analyze_by_cik(cik, years, report)
+                                                       : analyzer->analyze_by_ticker(ticker, years, report);
+                if (!result.error.empty()) {
+                    outcome.error = result.error;
+                } else {
+                    CachedAnalysis entry{std::make_shared<const AnalysisResult>(std::move(result)), {}};
+                    entry.json = ResultExporter::to_json(*entry.result);
+                    std::string etag = content_etag(entry.json);
+                    cache->set(key, entry, etag);
+                    outcome = outcome_of(entry, etag, cache->get_ttl());
+                }
+            } catch (const std::exception& e) {
+                LOG_ERROR("Analysis for {} failed: {}", key, e.what());
+                outcome.error = "Analysis failed";
+            }
+            landing->land(outcome);
+        });
+        if (!queued) {
+            AnalysisOutcome shed;
+            shed.shed = true;
+            landing->land(shed);
+        }
+    }
+    
+    bool cached(const std::string& ticker, const std::string& cik, int years) {
+        return cache_->contains(cache_key(ticker, cik, years));
+    }
+    
+    SingleFlightStats flight_stats() const { return flights_->stats(); }
+    
+private:
+    HttpServer& server_;
+    std::shared_ptr<FraudAnalyzer> analyzer_;
+    std::shared_ptr<AnalysisCache> cache_;
+    std::shared_ptr<ThreadPool> pool_;
+    std::shared_ptr<SingleFlight<AnalysisOutcome>> flights_;
+    std::shared_ptr<ProgressBoard> progress_;
+    
+    static AnalysisOutcome outcome_of(const CachedAnalysis& entry, const std::string& etag, int max_age) {
+        AnalysisOutcome outcome;
+        outcome.result = entry.result;
+        outcome.json = entry.json;
+        outcome.etag = etag;
+        outcome.max_age = max_age;
+        return outcome;
+    }
+};
+
+/**
+ * Server-Sent Events for one stream, pushed as the analysis reports them
+ * and pulled by the response as an AsyncBodyProducer: a pull takes
+ * everything queued, or parks until the next push.
+ */
+class EventQueue {
+public:
+    void push(std::string event, bool last) {
+        ChunkCallback waiting;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closed_) return;
+            closed_ = last;
+            if (!waiting_) {
+                pending_.append(event);
+                return;
+            }
+            waiting = std::move(waiting_);
+            waiting_ = nullptr;
+        }
+        waiting(std::move(event), !last);
+    }
+    
+    void pull(ChunkCallback next) {
+        std::string ready;
+        bool more = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pending_.empty() && !closed_) {
+                waiting_ = std::move(next);
+                return;
+            }
+            ready.swap(pending_);
+            more = !closed_;
+        }
+        next(std::move(ready), more);
+    }
+    
+private:
+    std::mutex mutex_;
+    std::string pending_;
+    ChunkCallback waiting_;
+    bool closed_ = false;       // The last event has been pushed
+};
+
+// An export's stand-in for a company whose analysis failed or was shed
+AnalysisResult failed_analysis(const std::string& ticker, const AnalysisOutcome& outcome) {
+    AnalysisResult result;
+    result.company.ticker = ticker;
+    result.analysis_timestamp = util::get_timestamp();
+    result.error = outcome.shed ? "Server overloaded, try again later" : outcome.error;
+    return result;
+}
+
 void setup_routes(HttpServer& server, std::shared_ptr<SECFetcher> fetcher,
                   std::shared_ptr<FraudAnalyzer> analyzer,
-                  std::shared_ptr<Cache<std::string>> cache) {
+                  std::shared_ptr<AnalysisCache> cache,
+                  std::shared_ptr<ThreadPool> analysis_pool) {
+    
+    auto analyses = std::make_shared<AnalysisService>(server, analyzer, cache, analysis_pool);
     
     // Health check endpoint
     server.get("/api/health", [cache](const HttpRequest& req) {
@@ -212,8 +614,132 @@ void setup_routes(HttpServer& server, std::shared_ptr<SECFetcher> fetcher,
         return HttpResponse::ok(json);
     });
     
-    // Company lookup by ticker
-    server.get("/api/company", [fetcher](const HttpRequest& req) {
+    // Server statistics endpoint
+    server.get("/api/stats", [&server, fetcher, analysis_pool, analyses](const HttpRequest& req) {
+        auto pool_json = [](const ThreadPoolStats& pool) {
+            JsonObject obj;
+            obj["threads"] = static_cast<double>(pool.thread_count);
+            obj["active"] = static_cast<double>(pool.active);
+            obj["queue_depth"] = static_cast<double>(pool.queue_depth);
+            obj["queue_capacity"] = static_cast<double>(pool.queue_capacity);
+            obj["submitted"] = static_cast<double>(pool.submitted);
+            obj["completed"] = static_cast<double>(pool.completed);
+            obj["rejected"] = static_cast<double>(pool.rejected);
+            obj["steals"] = static_cast<double>(pool.steals);
+            obj["avg_wait_ms"] = pool.avg_wait_ms;
+            obj["max_wait_ms"] = pool.max_wait_ms;
+            return obj;
+        };
+        
+        CompressionStats comp = server.get_compression_stats();
+        JsonObject compression;
+        compression["responses"] = static_cast<double>(comp.responses);
+        compression["bytes_in"] = static_cast<double>(comp.bytes_in);
+        compression["bytes_out"] = static_cast<double>(comp.bytes_out);
+        compression["bytes_saved"] = static_cast<double>(comp.bytes_in - comp.bytes_out);
+        compression["variant_cache_hits"] = static_cast<double>(comp.variant_cache_hits);
+        compression["variant_cache_entries"] = static_cast<double>(comp.variant_cache_entries);
+        compression["variant_cache_bytes"] = static_cast<double>(comp.variant_cache_bytes);
+        
+        JsonObject result;
+        result["workers"] = pool_json(server.get_worker_stats());
+        result["analysis"] = pool_json(analysis_pool->stats());
+        result["compression"] = compression;
+        
+        RateLimiterStats limits = server.get_rate_limit_stats();
+        JsonObject rate_limit;
+        rate_limit["allowed"] = static_cast<double>(limits.allowed);
+        rate_limit["limited"] = static_cast<double>(limits.limited);
+        rate_limit["evicted"] = static_cast<double>(limits.evicted);
+        rate_limit["clients"] = static_cast<double>(limits.clients);
+        result["rate_limit"] = rate_limit;
+        
+        AdmissionStats admission = server.get_admission_stats();
+        JsonObject overload;
+        overload["admitted"] = static_cast<double>(admission.admitted);
+        overload["shed_in_flight"] = static_cast<double>(admission.shed_in_flight);
+        overload["shed_queue"] = static_cast<double>(admission.shed_queue);
+        overload["in_flight"] = static_cast<double>(admission.in_flight);
+        overload["queue_delay_ms"] = admission.queue_delay_ms;
+        overload["standing_queue"] = admission.standing_queue;
+        result["admission"] = overload;
+        
+        auto flight_json = [](const SingleFlightStats& flights) {
+            JsonObject obj;
+            obj["computed"] = static_cast<double>(flights.leaders);
+            obj["shared"] = static_cast<double>(flights.shared);
+            obj["in_flight"] = static_cast<double>(flights.in_flight);
+            return obj;
+        };
+        JsonObject coalescing;
+        coalescing["analyses"] = flight_json(analyses->flight_stats());
+        coalescing["sec_fetches"] = flight_json(fetcher->get_fetch_stats());
+        result["coalescing"] = coalescing;
+        
+        HttpClientStats http = fetcher->get_http_stats();
+        JsonObject sec_http;
+        sec_http["requests"] = static_cast<double>(http.requests);
+        sec_http["connections_opened"] = static_cast<double>(http.connections_opened);
+        sec_http["connections_reused"] = static_cast<double>(http.connections_reused);
+        sec_http["retries"] = static_cast<double>(http.retries);
+        sec_http["idle_connections"] = static_cast<double>(http.idle_connections);
+        result["sec_http"] = sec_http;
+        
+        CompanyDirectoryStats directory = fetcher->get_directory_stats();
+        JsonObject company_directory;
+        company_directory["companies"] = static_cast<double>(directory.companies);
+        company_directory["refreshes"] = static_cast<double>(directory.refreshes);
+        company_directory["failures"] = static_cast<double>(directory.failures);
+        company_directory["age_seconds"] = static_cast<double>(directory.age_seconds);
+        result["company_directory"] = company_directory;
+        
+        ResponseCacheStats responses = fetcher->get_cache_stats();
+        JsonObject sec_cache;
+        sec_cache["entries"] = static_cast<double>(responses.entries);
+        sec_cache["bytes"] = static_cast<double>(responses.bytes);
+        sec_cache["hits"] = static_cast<double>(responses.hits);
+        sec_cache["revalidated"] = static_cast<double>(responses.revalidated);
+        sec_cache["misses"] = static_cast<double>(responses.misses);
+        sec_cache["evictions"] = static_cast<double>(responses.evictions);
+        result["sec_cache"] = sec_cache;
+        
+        return HttpResponse::ok(JsonValue(result).dump());
+    });
+    
+    // Prometheus scrape endpoint; state owned elsewhere is sampled at scrape time
+    auto& registry = MetricsRegistry::instance();
+    auto& queue_depth = registry.gauge("thread_pool_queue_depth", "Tasks waiting for a thread", {"pool"});
+    auto& pool_active = registry.gauge("thread_pool_active", "Tasks currently executing", {"pool"});
+    std::weak_ptr<ThreadPool> weak_pool = analysis_pool;
+    queue_depth.with({"workers"}).set_function([&server]() {
+        return static_cast<double>(server.get_worker_stats().queue_depth);
+    });
+    pool_active.with({"workers"}).set_function([&server]() {
+        return static_cast<double>(server.get_worker_stats().active);
+    });
+    queue_depth.with({"analysis"}).set_function([weak_pool]() {
+        auto pool = weak_pool.lock();
+        return pool ? static_cast<double>(pool->stats().queue_depth) : 0.0;
+    });
+    pool_active.with({"analysis"}).set_function([weak_pool]() {
+        auto pool = weak_pool.lock();
+        return pool ? static_cast<double>(pool->stats().active) : 0.0;
+    });
+    registry.gauge("http_requests_in_flight", "Requests admitted and not yet answered").with({})
+        .set_function([&server]() { return static_cast<double>(server.get_admission_stats().in_flight); });
+    std::weak_ptr<AnalysisCache> weak_cache = cache;
+    registry.gauge("cache_entries", "Entries in the response cache").with({})
+        .set_function([weak_cache]() {
+            auto entries = weak_cache.lock();
+            return entries ? static_cast<double>(entries->size()) : 0.0;
+        });
+    
+    server.get("/api/metrics", [](const HttpRequest& req) {
+        return HttpResponse::ok(MetricsRegistry::instance().render(), "text/plain; version=0.0.4; charset=utf-8");
+    });
+    
+    // Company lookup by ticker or CIK (/api/cik/{cik} is the path form)
+    RequestHandler company_handler = [fetcher](const HttpRequest& req) {
         std::string ticker = req.get_param("ticker");
         std::string cik = req.get_param("cik");
         
@@ -240,10 +766,13 @@ void setup_routes(HttpServer& server, std::shared_ptr<SECFetcher> fetcher,
         obj["sic"] = company->sic;
         
         return HttpResponse::ok(JsonValue(obj).dump());
-    });
+    };
+    server.get("/api/company", company_handler);
+    server.get("/api/cik/{cik}", company_handler);
     
-    // Main analysis endpoint
-    server.get("/api/analyze", [analyzer, cache](const HttpRequest& req) {
+    // Main analysis endpoint. A miss runs on the analysis executor, so a
+    // slow SEC fetch parks the request instead of holding a worker.
+    server.get_async("/api/analyze", [&server, analyses](const HttpRequest& req, ResponseCallback respond) {
         std::string ticker = req.get_param("ticker");
         std::string cik = req.get_param("cik");
         int years = 5;
@@ -253,37 +782,73 @@ void setup_routes(HttpServer& server, std::shared_ptr<SECFetcher> fetcher,
         } catch (...) {}
         
         if (ticker.empty() && cik.empty()) {
-            return HttpResponse::bad_request("Missing ticker or cik parameter");
+            respond(HttpResponse::bad_request("Missing ticker or cik parameter"));
+            return;
         }
         
-        // Check cache
-        std::string cache_key = "analysis:" + (ticker.empty() ? cik : ticker) + ":" + std::to_string(years);
-        auto cached = cache->get(cache_key);
-        if (cached) {
-            LOG_DEBUG("Cache hit for {}", cache_key);
-            return HttpResponse::ok(*cached);
-        }
+        // The server answers If-None-Match from the ETag
+        std::string cache_key = AnalysisService::cache_key(ticker, cik, years);
+        analyses->analyze(ticker, cik, years, [&server, respond, cache_key](const AnalysisOutcome& outcome) {
+            if (outcome.shed) {
+                respond(server.overloaded_response());
+            } else if (!outcome.result) {
+                respond(HttpResponse::error(500, outcome.error));
+            } else {
+                respond(analysis_response(outcome.json, outcome.etag, outcome.max_age, cache_key));
+            }
+        });
+    });
+    
+    // Analysis with progress pushed as Server-Sent Events: "progress" events,
+    // then one "result" (the /api/analyze JSON) or "error" event. The run is
+    // the shared one from AnalysisService, so concurrent streams and
+    // /api/analyze requests for the same company share a run and its progress.
+    server.get("/api/analyze/stream", [&server, analyses](const HttpRequest& req) {
+        std::string ticker = req.get_param("ticker");
+        std::string cik = req.get_param("cik");
+        int years = 5;
         
-        // Perform analysis
-        AnalysisResult result;
-        if (!ticker.empty()) {
-            result = analyzer->analyze_by_ticker(ticker, years);
-        } else {
-            result = analyzer->analyze_by_cik(cik, years);
+        try {
+            years = std::stoi(req.get_param("years", "5"));
+        } catch (...) {}
+        
+        if (ticker.empty() && cik.empty()) {
+            return HttpResponse::bad_request("Missing ticker or cik parameter");
         }
         
-        if (analyzer->has_error()) {
-            return HttpResponse::error(500, analyzer->get_last_error());
+        // Refused before the headers go out; a run shed later ends in an error event
+        if (server.overloaded(RequestPriority::BULK) && !analyses->cached(ticker, cik, years)) {
+            return server.overloaded_response();
         }
         
-        std::string json = ResultExporter::to_json(result);
-        cache->set(cache_key, json);
+        auto events = std::make_shared<EventQueue>();
+        analyses->analyze(ticker, cik, years,
+            [events](const AnalysisOutcome& outcome) {
+                if (outcome.result) {
+                    events->push(sse_event("result", outcome.json), true);
+                    return;
+                }
+                std::string error = outcome.shed ? "Server overloaded, try again later" : outcome.error;
+                events->push(sse_event("error", ResultExporter::error_json(error)), true);
+            },
+            [events](const AnalysisProgress& step) {
+                JsonObject event;
+                event["stage"] = step.stage;
+                event["detail"] = step.detail;
+                event["current"] = static_cast<double>(step.current);
+                event["total"] = static_cast<double>(step.total);
+                events->push(sse_event("progress", JsonValue(event).dump()), false);
+            });
         
-        return HttpResponse::ok(json);
+        HttpResponse stream = HttpResponse::async_stream([events](ChunkCallback next) {
+            events->pull(std::move(next));
+        }, "text/event-stream");
+        stream.headers["Cache-Control"] = "no-cache";
+        return stream;
     });
     
-    // Filings list endpoint
-    server.get("/api/filings", [fetcher](const HttpRequest& req) {
+    // Filings list endpoint, also at /api/company/{cik}/filings
+    RequestHandler filings_handler = [fetcher](const HttpRequest& req) {
         std::string ticker = req.get_param("ticker");
         std::string cik = req.get_param("cik");
         int years = 5;
@@ -322,7 +887,9 @@ void setup_routes(HttpServer& server, std::shared_ptr<SECFetcher> fetcher,
         result["count"] = static_cast<double>(filings.size());
         
         return HttpResponse::ok(JsonValue(result).dump());
-    });
+    };
+    server.get("/api/filings", filings_handler);
+    server.get("/api/company/{cik}/filings", filings_handler);
     
     // CIK search endpoint
     server.get("/api/cik/search", [fetcher](const HttpRequest& req) {
@@ -349,37 +916,77 @@ void setup_routes(HttpServer& server, std::shared_ptr<SECFetcher> fetcher,
     });
     
     // Cache management
-    server.post("/api/cache/clear", [cache](const HttpRequest& req) {
+    server.post("/api/cache/clear", [&server, cache, fetcher](const HttpRequest& req) {
         cache->clear();
+        fetcher->clear_cache();
+        server.clear_compression_cache();
         return HttpResponse::ok("{\"status\":\"cleared\"}");
     });
     
     // Export endpoints
-    server.get("/api/export/csv", [analyzer](const HttpRequest& req) {
-        // Similar to analyze but returns CSV
-        std::string ticker = req.get_param("ticker");
-        if (ticker.empty()) {
+    // Exports are streamed one company at a time, so a multi-company report
+    // never has more than one analysis in memory. Each company goes through
+    // the shared analysis path, and its section is rendered in the completion
+    // callback and handed back as the next chunk; no worker waits for it.
+    auto export_refusal = [&server, analyses](const std::vector<std::string>& tickers) -> std::optional<HttpResponse> {
+        if (tickers.empty()) {
             return HttpResponse::bad_request("Missing ticker parameter");
         }
+        if (tickers.size() > MAX_EXPORT_COMPANIES) {
+            return HttpResponse::bad_request("Too many tickers");
+        }
+        // Under load only reports built entirely from cached analyses go out
+        bool all_cached = std::all_of(tickers.begin(), tickers.end(), [&analyses](const std::string& ticker) {
+            return analyses->cached(ticker, {}, 5);
+        });
+        if (!all_cached && server.overloaded(RequestPriority::BULK)) {
+            return server.overloaded_response();
+        }
+        return std::nullopt;
+    };
+    
+    server.get("/api/export/csv", [analyses, export_refusal](const HttpRequest& req) {
+        auto tickers = export_tickers(req);
+        if (auto refusal = export_refusal(tickers)) {
+            return *refusal;
+        }
         
-        auto result = analyzer->analyze_by_ticker(ticker, 5);
-        std::string csv = ResultExporter::to_csv(result);
-        
-        HttpResponse res = HttpResponse::ok(csv, "text/csv");
+        HttpResponse res = HttpResponse::async_stream(
+            [analyses, tickers, index = size_t{0}](ChunkCallback next) mutable {
+                bool first = index == 0;
+                bool more = ++index < tickers.size();
+                const std::string& ticker = tickers[index - 1];
+                analyses->analyze(ticker, {}, 5, [ticker, first, more, next](const AnalysisOutcome& outcome) {
+                    std::string out = first ? "" : "\n";
+                    out += ResultExporter::to_csv(outcome.result ? *outcome.result
+                                                                 : failed_analysis(ticker, outcome));
+                    next(std::move(out), more);
+                });
+            }, "text/csv");
         res.headers["Content-Disposition"] = "attachment; filename=\"analysis.csv\"";
         return res;
     });
     
-    server.get("/api/export/html", [analyzer](const HttpRequest& req) {
-        std::string ticker = req.get_param("ticker");
-        if (ticker.empty()) {
-            return HttpResponse::bad_request("Missing ticker parameter");
+    server.get("/api/export/html", [analyses, export_refusal](const HttpRequest& req) {
+        auto tickers = export_tickers(req);
+        if (auto refusal = export_refusal(tickers)) {
+            return *refusal;
         }
         
-        auto result = analyzer->analyze_by_ticker(ticker, 5);
-        std::string html = ResultExporter::to_html(result);
-        
-        return HttpResponse::ok(html, "text/html");
+        std::string title = "Fraud Analysis Report - " + util::join(tickers, ", ");
+        return HttpResponse::async_stream(
+            [analyses, tickers, title, index = size_t{0}](ChunkCallback next) mutable {
+                bool first = index == 0;
+                bool more = ++index < tickers.size();
+                const std::string& ticker = tickers[index - 1];
+                std::string out = first ? ResultExporter::html_document_start(title) : "";
+                analyses->analyze(ticker, {}, 5, [out, ticker, more, next](const AnalysisOutcome& outcome) mutable {
+                    out += ResultExporter::html_report_section(outcome.result ? *outcome.result
+                                                                              : failed_analysis(ticker, outcome));
+                    if (!more) out += ResultExporter::html_document_end(SEC_ANALYZER_VERSION_STRING);
+                    next(std::move(out), more);
+                });
+            }, "text/html");
     });
 }
 
@@ -434,6 +1041,18 @@ int main(int argc, char* argv[]) {
         else if (arg == "--quiet") {
             config.log_level = "error";
         }
+        else if (arg == "--threads" && i + 1 < argc) {
+            config.thread_count = std::stoi(argv[++i]);
+        }
+        else if (arg == "--blocking-io") {
+            config.blocking_io = true;
+        }
+        else if (arg == "--io-threads" && i + 1 < argc) {
+            config.io_threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--reuse-port") {
+            config.reuse_port = true;
+        }
         else if (arg == "--log-level" && i + 1 < argc) {
             config.log_level = argv[++i];
         }
@@ -482,10 +1101,25 @@ int main(int argc, char* argv[]) {
     // Setup signal handlers
     std::signal(SIGINT, signal_handler);
     std::signal(SIGTERM, signal_handler);
+#ifndef _WIN32
+    // A peer closing mid-write (TLS writes use write(2)) should fail the write, not kill us
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
     
     // Create shared components
-    auto cache = std::make_shared<Cache<std::string>>(config.cache_ttl_seconds);
+    auto cache = std::make_shared<AnalysisCache>(config.cache_ttl_seconds);
     auto fetcher = std::make_shared<SECFetcher>(config.sec_user_agent);
+    if (!config.sec_base_url.empty()) {
+        LOG_INFO("Fetching SEC data from {}", config.sec_base_url);
+        fetcher->set_base_url(config.sec_base_url);
+    }
+    if (config.sec_cache.max_mb > 0) {
+        fetcher->set_cache(std::make_shared<ResponseCache>(static_cast<size_t>(config.sec_cache.max_mb) * 1024 * 1024),
+                           config.sec_cache);
+    }
+    if (config.directory_refresh_seconds > 0) {
+        fetcher->start_directory_refresh(std::chrono::seconds(config.directory_refresh_seconds));
+    }
     auto analyzer = std::make_shared<FraudAnalyzer>(config.weights);
     analyzer->set_fetcher(fetcher);
     
@@ -494,9 +1128,55 @@ int main(int argc, char* argv[]) {
     g_server->set_port(config.port);
     g_server->set_static_dir(config.static_dir);
     g_server->set_cors_enabled(config.enable_cors);
+    g_server->set_io_mode(config.blocking_io ? IoMode::BLOCKING : IoMode::EVENT_LOOP);
+    g_server->set_io_threads(config.io_threads);
+    g_server->set_reuse_port(config.reuse_port);
+    g_server->set_pin_io_threads(config.pin_io_threads);
+    g_server->set_thread_count(config.thread_count);
+    g_server->set_keep_alive_timeout(config.keep_alive_timeout_seconds);
+    g_server->set_max_requests_per_connection(config.max_requests_per_connection);
+    g_server->set_timeouts(config.header_timeout_seconds, config.body_timeout_seconds,
+                           config.write_timeout_seconds);
+    g_server->set_max_body_size(static_cast<size_t>(std::max(1, config.max_body_size_kb)) * 1024);
+    g_server->set_queue_capacity(static_cast<size_t>(std::max(1, config.worker_queue_size)));
+    g_server->set_compression(config.compression_level,
+                              static_cast<size_t>(std::max(0, config.compression_min_size)));
+    if (config.compression_cache_mb > 0) {
+        // Sized apart from the analyses so variants never crowd them out
+        g_server->set_compression_cache(
+            std::make_shared<ResponseCache>(static_cast<size_t>(config.compression_cache_mb) * 1024 * 1024),
+            std::chrono::seconds(std::max(1, config.cache_ttl_seconds)));
+    }
+    if (config.rate_limit_per_minute > 0) {
+        if (!config.rate_limit_key_header.empty() && config.rate_limit_keys.empty()) {
+            LOG_WARNING("rate_limit_key_header is set but rate_limit_keys is empty; clients are keyed by IP");
+        }
+        g_server->set_rate_limiter(
+            std::make_shared<RateLimiter>(config.rate_limit_per_minute, config.rate_limit_burst),
+            config.rate_limit_key_header,
+            std::unordered_set<std::string>(config.rate_limit_keys.begin(), config.rate_limit_keys.end()));
+        g_server->exempt_from_rate_limit("/api/health");
+        g_server->exempt_from_rate_limit("/api/metrics");
+    }
+    if (config.max_in_flight > 0 || config.queue_target_ms > 0) {
+        AdmissionConfig admission;
+        admission.max_in_flight = static_cast<size_t>(std::max(0, config.max_in_flight));
+        admission.target_delay = std::chrono::milliseconds(std::max(0, config.queue_target_ms));
+        admission.interval = std::chrono::milliseconds(std::max(1, config.queue_interval_ms));
+        admission.retry_after_seconds = std::max(1, config.overload_retry_after);
+        g_server->set_admission_controller(std::make_shared<AdmissionController>(admission));
+        g_server->set_route_priority("/api/health", RequestPriority::CRITICAL);
+        g_server->set_route_priority("/api/metrics", RequestPriority::CRITICAL);
+    }
+    
+    // Deferred analyses run here rather than on the request workers
+    auto analysis_pool = std::make_shared<ThreadPool>(
+        static_cast<size_t>(std::max(1, config.analysis_threads)),
+        static_cast<size_t>(std::max(1, config.analysis_queue_size)));
+    analysis_pool->start();
     
     // Setup API routes
-    setup_routes(*g_server, fetcher, analyzer, cache);
+    setup_routes(*g_server, fetcher, analyzer, cache, analysis_pool);
     
     // Start server
     if (!g_server->start()) {
@@ -512,6 +1192,10 @@ int main(int argc, char* argv[]) {
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
     
+    // Parked analyses are answered (or dropped with a 503) before exit
+    analysis_pool->shutdown();
+    fetcher->stop_directory_refresh();
+    
     LOG_INFO("Server stopped");
     return 0;
 }
@@ -0,0 +1,225 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Metrics Registry Implementation
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ */
+
+#include <sec_analyzer/metrics.h>
+
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+namespace sec_analyzer {
+
+namespace {
+
+void append_number(std::string& out, double value) {
+    if (std::isnan(value)) {
+        out.append("NaN");
+    } else if (std::isinf(value)) {
+        out.append(value > 0 ? "+Inf" : "-Inf");
+    } else {
+        char digits[32];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    }
+}
+
+void append_number(std::string& out, uint64_t value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+// Label values escape backslash, double quote and newline; help text the first and last
+void append_escaped(std::string& out, std::string_view text, bool quotes) {
+    for (char c : text) {
+        if (c == '\\') out.append("\\\\");
+        else if (c == '\n') out.append("\\n");
+        else if (c == '"' && quotes) out.append("\\\"");
+        else out.push_back(c);
+    }
+}
+
+} // namespace
+
+uint64_t Counter::value() const {
+    uint64_t total = 0;
+    for (const Slot& slot : slots_) {
+        total += slot.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Gauge::add(double delta) {
+    double current = value_.load(std::memory_order_relaxed);
+    while (!value_.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {}
+}
+
+void Gauge::set_function(std::function<double()> fn) {
+    std::lock_guard<std::mutex> lock(function_mutex_);
+    function_ = std::move(fn);
+}
+
+double Gauge::value() const {
+    {
+        std::lock_guard<std::mutex> lock(function_mutex_);
+        if (function_) return function_();
+    }
+    return value_.load(std::memory_order_relaxed);
+}
+
+size_t Histogram::bucket_of(uint64_t nanos) {
+    if (nanos < (uint64_t{1} << MIN_EXPONENT)) return 0;
+    int exponent = std::bit_width(nanos) - 1;
+    if (exponent >= MAX_EXPONENT) return BUCKET_COUNT - 1;
+    // The two bits below the leading one pick the linear step within the octave
+    size_t step = static_cast<size_t>(nanos >> (exponent - 2)) & (SUB_BUCKETS - 1);
+    return 1 + static_cast<size_t>(exponent - MIN_EXPONENT) * SUB_BUCKETS + step;
+}
+
+double Histogram::upper_bound(size_t bucket) {
+    if (bucket == 0) return static_cast<double>(uint64_t{1} << MIN_EXPONENT) / 1e9;
+    size_t exponent = MIN_EXPONENT + (bucket - 1) / SUB_BUCKETS;
+    size_t step = (bucket - 1) % SUB_BUCKETS;
+    return static_cast<double>((SUB_BUCKETS + step + 1) << (exponent - 2)) / 1e9;
+}
+
+void Histogram::observe(std::chrono::nanoseconds duration) {
+    uint64_t nanos = static_cast<uint64_t>(std::max<int64_t>(0, duration.count()));
+    Shard& shard = shards_[metrics_detail::shard_index()];
+    shard.counts[bucket_of(nanos)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum_nanos.fetch_add(nanos, std::memory_order_relaxed);
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot snapshot;
+    uint64_t sum_nanos = 0;
+    for (const Shard& shard : shards_) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            uint64_t count = shard.counts[i].load(std::memory_order_relaxed);
+            snapshot.counts[i] += count;
+            snapshot.count += count;
+        }
+        sum_nanos += shard.sum_nanos.load(std::memory_order_relaxed);
+    }
+    snapshot.sum_seconds = static_cast<double>(sum_nanos) / 1e9;
+    return snapshot;
+}
+
+std::string MetricFamilyBase::label_text(const std::vector<std::string>& values,
+                                         std::string_view extra_name, std::string_view extra_value) const {
+    std::string out;
+    for (size_t i = 0; i < label_names_.size() && i < values.size(); ++i) {
+        out.append(out.empty() ? "{" : ",");
+        out.append(label_names_[i]).append("=\"");
+        append_escaped(out, values[i], true);
+        out.push_back('"');
+    }
+    if (!extra_name.empty()) {
+        out.append(out.empty() ? "{" : ",");
+        out.append(extra_name).append("=\"").append(extra_value).push_back('"');
+    }
+    if (!out.empty()) out.push_back('}');
+    return out;
+}
+
+template<> const char* MetricFamily<Counter>::type() const { return "counter"; }
+template<> const char* MetricFamily<Gauge>::type() const { return "gauge"; }
+template<> const char* MetricFamily<Histogram>::type() const { return "histogram"; }
+
+template<>
+void MetricFamily<Counter>::render(std::string& out) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    for (const auto& [key, child] : children_) {
+        out.append(name_).append(label_text(child.label_values)).push_back(' ');
+        append_number(out, child.metric->value());
+        out.push_back('\n');
+    }
+}
+
+template<>
+void MetricFamily<Gauge>::render(std::string& out) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    for (const auto& [key, child] : children_) {
+        out.append(name_).append(label_text(child.label_values)).push_back(' ');
+        append_number(out, child.metric->value());
+        out.push_back('\n');
+    }
+}
+
+template<>
+void MetricFamily<Histogram>::render(std::string& out) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::string bound;
+    for (const auto& [key, child] : children_) {
+        Histogram::Snapshot snapshot = child.metric->snapshot();
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < Histogram::BUCKET_COUNT; ++i) {
+            cumulative += snapshot.counts[i];
+            bound.clear();
+            if (i + 1 < Histogram::BUCKET_COUNT) {
+                append_number(bound, Histogram::upper_bound(i));
+            } else {
+                bound = "+Inf";
+            }
+            out.append(name_).append("_bucket").append(label_text(child.label_values, "le", bound)).push_back(' ');
+            append_number(out, cumulative);
+            out.push_back('\n');
+        }
+        std::string labels = label_text(child.label_values);
+        out.append(name_).append("_sum").append(labels).push_back(' ');
+        append_number(out, snapshot.sum_seconds);
+        out.push_back('\n');
+        out.append(name_).append("_count").append(labels).push_back(' ');
+        append_number(out, snapshot.count);
+        out.push_back('\n');
+    }
+}
+
+template<typename F>
+F& MetricsRegistry::family(const std::string& name, const std::string& help,
+                           std::vector<std::string> label_names) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+        it = families_.emplace(name, std::make_unique<F>(name, help, std::move(label_names))).first;
+    }
+    auto* family = dynamic_cast<F*>(it->second.get());
+    if (!family) {
+        throw std::logic_error("Metric " + name + " already registered as a " + it->second->type());
+    }
+    return *family;
+}
+
+CounterFamily& MetricsRegistry::counter(const std::string& name, const std::string& help,
+                                        std::vector<std::string> label_names) {
+    return family<CounterFamily>(name, help, std::move(label_names));
+}
+
+GaugeFamily& MetricsRegistry::gauge(const std::string& name, const std::string& help,
+                                    std::vector<std::string> label_names) {
+    return family<GaugeFamily>(name, help, std::move(label_names));
+}
+
+HistogramFamily& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                            std::vector<std::string> label_names) {
+    return family<HistogramFamily>(name, help, std::move(label_names));
+}
+
+std::string MetricsRegistry::render() const {
+    std::string out;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [name, family] : families_) {
+        out.append("# HELP ").append(name).push_back(' ');
+        append_escaped(out, family->help(), false);
+        out.append("\n# TYPE ").append(name).push_back(' ');
+        out.append(family->type()).push_back('\n');
+        family->render(out);
+    }
+    return out;
+}
+
+} // namespace sec_analyzer
@@ -0,0 +1,110 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Client Rate Limiter Implementation
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ */
+
+#include <sec_analyzer/rate_limiter.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace sec_analyzer {
+
+namespace {
+
+constexpr int64_t NS_PER_SECOND = 1000000000;
+constexpr int64_t SWEEP_INTERVAL_NS = 10 * NS_PER_SECOND;
+
+} // namespace
+
+RateLimiter::RateLimiter(int per_minute, int burst, size_t max_clients)
+    : per_minute_(std::max(1, per_minute)),
+      shards_(std::make_unique<std::array<Shard, SHARD_COUNT>>()) {
+    if (burst <= 0) {
+        burst = per_minute_;
+    }
+    interval_ns_ = 60 * NS_PER_SECOND / per_minute_;
+    tolerance_ns_ = interval_ns_ * (burst - 1);
+    max_per_shard_ = std::max<size_t>(1, max_clients / SHARD_COUNT);
+}
+
+int64_t RateLimiter::now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+RateLimitDecision RateLimiter::acquire(std::string_view client) {
+    Shard& shard = (*shards_)[KeyHash()(client) % SHARD_COUNT];
+    int64_t now = now_ns();
+
+    int64_t due = shard.next_sweep.load(std::memory_order_relaxed);
+    if (now >= due && shard.next_sweep.compare_exchange_strong(due, now + SWEEP_INTERVAL_NS)) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        sweep(shard, now);
+    }
+
+    // Known client: one CAS under the shared lock
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.buckets.find(client);
+        if (it != shard.buckets.end()) {
+            return take(it->second, now);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (shard.buckets.size() >= max_per_shard_ && shard.buckets.find(client) == shard.buckets.end()) {
+        sweep(shard, now);
+        if (shard.buckets.size() >= max_per_shard_) {
+            auto oldest = std::min_element(shard.buckets.begin(), shard.buckets.end(),
+                [](const auto& a, const auto& b) { return a.second.load() < b.second.load(); });
+            shard.buckets.erase(oldest);
+            ++evicted_;
+        }
+    }
+    auto [it, inserted] = shard.buckets.try_emplace(std::string(client), now);
+    return take(it->second, now);
+}
+
+RateLimitDecision RateLimiter::take(std::atomic<int64_t>& tat, int64_t now) {
+    int64_t current = tat.load(std::memory_order_relaxed);
+    while (true) {
+        int64_t start = std::max(current, now);
+        if (start - now > tolerance_ns_) {
+            ++limited_;
+            int64_t wait = start - now - tolerance_ns_;
+            RateLimitDecision decision;
+            decision.allowed = false;
+            decision.retry_after_seconds = static_cast<int>((wait + NS_PER_SECOND - 1) / NS_PER_SECOND);
+            return decision;
+        }
+        if (tat.compare_exchange_weak(current, start + interval_ns_, std::memory_order_relaxed)) {
+            ++allowed_;
+            return RateLimitDecision{};
+        }
+    }
+}
+
+void RateLimiter::sweep(Shard& shard, int64_t now) {
+    for (auto it = shard.buckets.begin(); it != shard.buckets.end();) {
+        if (it->second.load(std::memory_order_relaxed) <= now) {
+            it = shard.buckets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+RateLimiterStats RateLimiter::stats() const {
+    RateLimiterStats s;
+    s.allowed = allowed_;
+    s.limited = limited_;
+    s.evicted = evicted_;
+    for (const Shard& shard : *shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        s.clients += shard.buckets.size();
+    }
+    return s;
+}
+
+} // namespace sec_analyzer
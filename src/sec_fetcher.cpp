@@ -8,6 +8,8 @@
 #include <sec_analyzer/logger.h>
 #include <sec_analyzer/util.h>
 #include <sec_analyzer/json.h>
+#include <sec_analyzer/fact_index.h>
+#include <sec_analyzer/metrics.h>
 
 #ifdef _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
@@ -36,16 +38,115 @@
 
 namespace sec_analyzer {
 
-SECFetcher::SECFetcher() : user_agent_("SECFraudAnalyzer/2.1.2 (educational@example.com)") {
-    last_request_time_ = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+namespace {
+
+struct FetchMetrics {
+    Histogram& ok_duration;
+    Histogram& error_duration;
+    Counter& bytes;
+    Counter& cache_hit;
+    Counter& cache_revalidated;
+    Counter& cache_miss;
+
+    static FetchMetrics& get() {
+        auto& registry = MetricsRegistry::instance();
+        auto& duration = registry.histogram("sec_fetch_duration_seconds",
+            "SEC EDGAR request latency, excluding rate-limit waits", {"result"});
+        auto& cache = registry.counter("cache_requests_total", "Cache lookups by cache and result",
+            {"cache", "result"});
+        static FetchMetrics metrics{
+            duration.with({"ok"}),
+            duration.with({"error"}),
+            registry.counter("sec_fetch_bytes_total", "Response bytes received from SEC EDGAR").with({}),
+            cache.with({"sec", "hit"}),
+            cache.with({"sec", "revalidated"}),
+            cache.with({"sec", "miss"})
+        };
+        return metrics;
+    }
+};
+
+// Every us-gaap concept extract_financial_data reads; the fact index skips the rest
+constexpr std::string_view FINANCIAL_CONCEPTS[] = {
+    "Revenues", "RevenueFromContractWithCustomerExcludingAssessedTax", "SalesRevenueNet",
+    "NetIncomeLoss", "OperatingIncomeLoss", "GrossProfit", "CostOfGoodsAndServicesSold", "CostOfRevenue",
+    "Assets", "Liabilities", "StockholdersEquity", "AssetsCurrent", "LiabilitiesCurrent",
+    "CashAndCashEquivalentsAtCarryingValue", "AccountsReceivableNetCurrent", "InventoryNet", "LongTermDebt",
+    "NetCashProvidedByUsedInOperatingActivities", "NetCashProvidedByUsedInInvestingActivities",
+    "NetCashProvidedByUsedInFinancingActivities", "PaymentsToAcquirePropertyPlantAndEquipment"
+};
+
+std::string http_status_error(long status) {
+    std::string message = "HTTP error " + std::to_string(status);
+    if (status == 403) {
+        message += " - SEC requires valid User-Agent with email";
+    } else if (status == 404) {
+        message += " - Resource not found";
+    } else if (status == 429) {
+        message += " - Rate limited, please wait";
+    }
+    return message;
+}
+
+// parse_json timed into sec_json_parse_duration_seconds{document}
+JsonValue parse_timed(const std::string& json, std::string_view document) {
+    static auto& family = MetricsRegistry::instance().histogram("sec_json_parse_duration_seconds",
+        "Time to parse SEC EDGAR JSON documents", {"document"});
+    ScopedTimer timer(family.with({document}));
+    return parse_json(json);
 }
 
-SECFetcher::SECFetcher(const std::string& user_agent) : user_agent_(user_agent) {
+} // namespace
+
+SECFetcher::SECFetcher() : SECFetcher("SECFraudAnalyzer/2.1.2 (educational@example.com)") {}
+
+SECFetcher::SECFetcher(const std::string& user_agent)
+    : user_agent_(user_agent), directory_([this](std::string& error) { return load_company_tickers(error); }) {
     last_request_time_ = std::chrono::steady_clock::now() - std::chrono::seconds(1);
 }
 
 SECFetcher::~SECFetcher() = default;
 
+void SECFetcher::set_timeout(int seconds) {
+    timeout_seconds_ = seconds;
+#ifndef _WIN32
+    http_.set_timeout(seconds);
+#endif
+}
+
+void SECFetcher::set_base_url(const std::string& base_url) {
+#ifndef _WIN32
+    http_.set_base_url(base_url);
+#else
+    if (!base_url.empty()) LOG_WARNING("SEC base URL override is not supported on Windows");
+#endif
+}
+
+void SECFetcher::set_cache(std::shared_ptr<ResponseCache> cache, const SecCacheConfig& config) {
+    cache_ = std::move(cache);
+    cache_config_ = config;
+}
+
+std::chrono::seconds SECFetcher::cache_ttl(const std::string& url) const {
+    int seconds = cache_config_.documents_ttl;
+    if (url.find("/company_tickers") != std::string::npos) {
+        seconds = cache_config_.tickers_ttl;
+    } else if (url.find("/submissions/") != std::string::npos) {
+        seconds = cache_config_.submissions_ttl;
+    } else if (url.find("/companyfacts/") != std::string::npos) {
+        seconds = cache_config_.company_facts_ttl;
+    }
+    return std::chrono::seconds(std::max(0, seconds));
+}
+
+HttpClientStats SECFetcher::get_http_stats() const {
+#ifndef _WIN32
+    return http_.stats();
+#else
+    return {};
+#endif
+}
+
 void SECFetcher::rate_limit() {
     std::lock_guard<std::mutex> lock(rate_limit_mutex_);
     auto now = std::chrono::steady_clock::now();
@@ -58,78 +159,42 @@ void SECFetcher::rate_limit() {
     last_request_time_ = std::chrono::steady_clock::now();
 }
 
-std::optional<CompanyInfo> SECFetcher::lookup_company_by_ticker(const std::string& ticker) {
-    LOG_INFO("Looking up company by ticker: {}", ticker);
-    
-    // Normalize ticker: convert periods to hyphens (BRK.A -> BRK-A)
-    std::string normalized_ticker = ticker;
-    for (char& c : normalized_ticker) {
-        if (c == '.') c = '-';
+std::optional<JsonValue> SECFetcher::load_company_tickers(std::string& error) {
+    auto json = fetch_json(sec_urls::COMPANY_TICKERS, &error);
+    if (!json) {
+        LOG_ERROR("Failed to fetch company tickers: {}", error);
+        return std::nullopt;
     }
-    
-    // Check cache first
-    std::string cache_key = "company:ticker:" + normalized_ticker;
-    if (cache_) {
-        auto cached = cache_->get(cache_key);
-        if (cached) {
-            return parse_company_info(*cached);
-        }
+    try {
+        return parse_timed(*json, "tickers");
+    } catch (const std::exception& e) {
+        LOG_ERROR("Company tickers parse error: {}", e.what());
+        error = std::string("Parse error: ") + e.what();
+        return std::nullopt;
     }
+}
+
+std::optional<CompanyInfo> SECFetcher::lookup_company_by_ticker(const std::string& ticker, std::string* error) {
+    LOG_INFO("Looking up company by ticker: {}", ticker);
     
-    // Fetch from SEC
-    auto json = fetch_json(sec_urls::COMPANY_TICKERS);
-    if (!json) {
-        LOG_ERROR("Failed to fetch company tickers: {}", last_error_);
-        last_error_ = "Failed to fetch company tickers: " + last_error_;
+    std::string reason;
+    if (!directory_.ensure_loaded(&reason)) {
+        if (error) *error = "Failed to fetch company tickers: " + reason;
         return std::nullopt;
     }
     
-    LOG_DEBUG("Received {} bytes from SEC", json->size());
-    
-    // Parse and find ticker
-    try {
-        auto data = parse_json(*json);
-        
-        if (!data.is_object()) {
-            LOG_ERROR("SEC response is not a JSON object");
-            last_error_ = "Invalid SEC response format";
-            return std::nullopt;
-        }
-        
-        const auto& obj = data.as_object();
-        LOG_DEBUG("Parsed JSON with {} entries", obj.size());
-        
-        std::string ticker_upper = util::to_upper(normalized_ticker);
-        
-        // SEC company_tickers.json is object with numeric keys
-        for (const auto& item : obj) {
-            const auto& value = item.second;
-            if (value.is_object() && value.contains("ticker")) {
-                std::string entry_ticker = value.at("ticker").as_string();
-                if (util::to_upper(entry_ticker) == ticker_upper) {
-                    CompanyInfo info;
-                    info.ticker = entry_ticker;
-                    info.name = value.contains("title") ? value.at("title").as_string() : "";
-                    info.cik = normalize_cik(std::to_string(value.at("cik_str").as_int()));
-                    LOG_INFO("Found company: {} (CIK: {})", info.name, info.cik);
-                    return info;
-                }
-            }
-        }
-        
-        LOG_WARNING("Ticker {} not found in {} entries", ticker, obj.size());
-        
-    } catch (const std::exception& e) {
-        LOG_ERROR("JSON parse error: {}", e.what());
-        last_error_ = std::string("Parse error: ") + e.what();
+    auto info = directory_.find_ticker(ticker);
+    if (!info) {
+        LOG_WARNING("Ticker {} not found in company directory", ticker);
+        if (error) *error = "Company not found: " + ticker;
         return std::nullopt;
     }
     
-    last_error_ = "Company not found: " + ticker;
-    return std::nullopt;
+    LOG_INFO("Found company: {} (CIK: {})", info->name, info->cik);
+    return info;
 }
 
-std::optional<CompanyInfo> SECFetcher::lookup_company_by_cik(const std::string& cik) {
+std::optional<CompanyInfo> SECFetcher::lookup_company_by_cik(const std::string& cik, std::string* error) {
     LOG_INFO("Looking up company by CIK: {}", cik);
     
     std::string normalized = normalize_cik(cik);
@@ -137,43 +202,25 @@ std::optional<CompanyInfo> SECFetcher::lookup_company_by_cik(const std::string&
     
     auto json = fetch_url(url);
     if (!json) {
-        last_error_ = "Failed to fetch company info for CIK: " + cik;
+        if (error) *error = "Failed to fetch company info for CIK: " + cik;
         return std::nullopt;
     }
     
-    return parse_company_info(*json);
+    CompanyInfo info = parse_company_info(*json);
+    
+    // Submissions omit tickers for some filers; the directory may still list one
+    if (info.ticker.empty() || info.name.empty()) {
+        if (auto listed = directory_.find_cik(normalized)) {
+            if (info.ticker.empty()) info.ticker = listed->ticker;
+            if (info.name.empty()) info.name = listed->name;
+        }
+    }
+    return info;
 }
 
 std::vector<CompanyInfo> SECFetcher::search_companies(const std::string& query) {
-    std::vector<CompanyInfo> results;
-    
-    auto json = fetch_json(sec_urls::COMPANY_TICKERS);
-    if (!json) return results;
-    
-    std::string query_upper = util::to_upper(query);
-    
-    try {
-        auto data = parse_json(*json);
-        for (const auto& item : data.as_object()) {
-            const auto& value = item.second;
-            if (value.is_object()) {
-                std::string name = value.contains("title") ? util::to_upper(value.at("title").as_string()) : "";
-                std::string ticker = value.contains("ticker") ? util::to_upper(value.at("ticker").as_string()) : "";
-                
-                if (name.find(query_upper) != std::string::npos || ticker.find(query_upper) != std::string::npos) {
-                    CompanyInfo info;
-                    info.ticker = value.at("ticker").as_string();
-                    info.name = value.contains("title") ? value.at("title").as_string() : "";
-                    info.cik = normalize_cik(std::to_string(value.at("cik_str").as_int()));
-                    results.push_back(info);
-                    
-                    if (results.size() >= 10) break;
-                }
-            }
-        }
-    } catch (...) {}
-    
-    return results;
+    if (!directory_.ensure_loaded()) return {};
+    return directory_.search(query);
 }
 
 std::vector<Filing> SECFetcher::get_filings(const std::string& cik, int years) {
@@ -212,7 +259,9 @@ std::optional<std::string> SECFetcher::get_filing_document(const std::string& ac
     std::string url = sec_urls::BASE + "/Archives/edgar/data/" + clean_accession + "/" + filename;
     LOG_DEBUG("Fetching document: {}", url);
     
-    return fetch_url(url);
+    auto document = fetch_url(url);
+    if (!document) return std::nullopt;
+    return *document;
 }
 
 std::string SECFetcher::ticker_to_cik(const std::string& ticker) {
@@ -223,44 +272,75 @@ std::string SECFetcher::ticker_to_cik(const std::string& ticker) {
     return "";
 }
 
-// Helper to extract value from company facts for a specific concept and period
-static double extract_fact_value(const JsonValue& facts, const std::string& concept_name, 
-                                  const std::string& accession, int fiscal_year, bool annual) {
+std::optional<FactIndex> SECFetcher::get_company_facts(const std::string& cik, std::string& error) {
+    std::string url = sec_urls::COMPANY_FACTS + "/CIK" + normalize_cik(cik) + ".json";
+    auto json = fetch_url(url, &error);
+    if (!json) {
+        LOG_WARNING("Failed to fetch company facts for CIK {}: {}", cik, error);
+        return std::nullopt;
+    }
+    
     try {
-        if (!facts.contains("us-gaap")) return 0.0;
-        const auto& us_gaap = facts.at("us-gaap");
-        
-        if (!us_gaap.contains(concept_name)) return 0.0;
-        const auto& concept_data = us_gaap.at(concept_name);
-        
-        if (!concept_data.contains("units")) return 0.0;
-        const auto& units = concept_data.at("units");
-        
-        // Try USD first, then pure
-        const char* unit_types[] = {"USD", "pure", "shares"};
-        for (const char* unit_type : unit_types) {
-            if (!units.contains(unit_type)) continue;
-            const auto& values = units.at(unit_type);
-            
-            for (size_t i = 0; i < values.size(); ++i) {
-                const auto& entry = values[i];
-                if (!entry.contains("fy") || !entry.contains("val")) continue;
-                
-                int fy = entry.at("fy").as_int();
-                std::string form = entry.contains("form") ? entry.at("form").as_string() : "";
-                std::string fp = entry.contains("fp") ? entry.at("fp").as_string() : "";
-                
-                // Match by fiscal year and form type
-                if (fy == fiscal_year) {
-                    if ((annual && (form == "10-K" || fp == "FY")) ||
-                        (!annual && (form == "10-Q" || fp == "Q1" || fp == "Q2" || fp == "Q3"))) {
-                        return entry.at("val").as_number();
-                    }
-                }
-            }
+        auto facts_data = parse_timed(*json, "companyfacts");
+        if (!facts_data.contains("facts")) {
+            LOG_WARNING("No facts in company data");
+            return std::nullopt;
         }
-    } catch (...) {}
-    return 0.0;
+        return FactIndex(facts_data.at("facts"), FINANCIAL_CONCEPTS);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Failed to parse company facts: {}", e.what());
+        error = e.what();
+        return std::nullopt;
+    }
+}
+
+FinancialData SECFetcher::extract_financial_data(const FactIndex& facts, const Filing& filing) {
+    FinancialData data;
+    data.filing = filing;
+    data.is_valid = false;
+    
+    bool is_annual = filing.is_annual();
+    int fy = filing.fiscal_year > 0 ? filing.fiscal_year : 2024;  // Default to recent
+    
+    // Extract income statement data
+    data.income_statement.revenue = facts.value("Revenues", fy, is_annual);
+    if (data.income_statement.revenue == 0) {
+        data.income_statement.revenue = facts.value("RevenueFromContractWithCustomerExcludingAssessedTax", fy, is_annual);
+    }
+    if (data.income_statement.revenue == 0) {
+        data.income_statement.revenue = facts.value("SalesRevenueNet", fy, is_annual);
+    }
+    
+    data.income_statement.net_income = facts.value("NetIncomeLoss", fy, is_annual);
+    data.income_statement.operating_income = facts.value("OperatingIncomeLoss", fy, is_annual);
+    data.income_statement.gross_profit = facts.value("GrossProfit", fy, is_annual);
+    data.income_statement.cost_of_revenue = facts.value("CostOfGoodsAndServicesSold", fy, is_annual);
+    if (data.income_statement.cost_of_revenue == 0) {
+        data.income_statement.cost_of_revenue = facts.value("CostOfRevenue", fy, is_annual);
+    }
+    
+    // Extract balance sheet data
+    data.balance_sheet.total_assets = facts.value("Assets", fy, is_annual);
+    data.balance_sheet.total_liabilities = facts.value("Liabilities", fy, is_annual);
+    data.balance_sheet.total_equity = facts.value("StockholdersEquity", fy, is_annual);
+    data.balance_sheet.current_assets = facts.value("AssetsCurrent", fy, is_annual);
+    data.balance_sheet.current_liabilities = facts.value("LiabilitiesCurrent", fy, is_annual);
+    data.balance_sheet.cash = facts.value("CashAndCashEquivalentsAtCarryingValue", fy, is_annual);
+    data.balance_sheet.accounts_receivable = facts.value("AccountsReceivableNetCurrent", fy, is_annual);
+    data.balance_sheet.inventory = facts.value("InventoryNet", fy, is_annual);
+    data.balance_sheet.long_term_debt = facts.value("LongTermDebt", fy, is_annual);
+    
+    // Extract cash flow data
+    data.cash_flow.operating_cash_flow = facts.value("NetCashProvidedByUsedInOperatingActivities", fy, is_annual);
+    data.cash_flow.investing_cash_flow = facts.value("NetCashProvidedByUsedInInvestingActivities", fy, is_annual);
+    data.cash_flow.financing_cash_flow = facts.value("NetCashProvidedByUsedInFinancingActivities", fy, is_annual);
+    data.cash_flow.capital_expenditures = facts.value("PaymentsToAcquirePropertyPlantAndEquipment", fy, is_annual);
+    
+    data.is_valid = (data.income_statement.revenue > 0 || data.balance_sheet.total_assets > 0);
+    
+    LOG_INFO("Extracted financial data - Revenue: ${:.0f}M, Net Income: ${:.0f}M", 
+             data.income_statement.revenue / 1e6, data.income_statement.net_income / 1e6);
+    return data;
 }
 
 std::optional<FinancialData> SECFetcher::get_financial_data(const Filing& filing) {
@@ -276,85 +356,38 @@ std::optional<FinancialData> SECFetcher::get_financial_data(const Filing& filing
         return data;
     }
     
-    // Fetch company facts
-    std::string url = sec_urls::COMPANY_FACTS + "/CIK" + normalize_cik(filing.cik) + ".json";
-    auto json = fetch_url(url);
-    if (!json) {
-        LOG_WARNING("Failed to fetch company facts for CIK {}", filing.cik);
-        return data;
-    }
-    
-    try {
-        auto facts_data = parse_json(*json);
-        if (!facts_data.contains("facts")) {
-            LOG_WARNING("No facts in company data");
-            return data;
-        }
-        
-        const auto& facts = facts_data.at("facts");
-        bool is_annual = filing.is_annual();
-        int fy = filing.fiscal_year > 0 ? filing.fiscal_year : 2024;  // Default to recent
-        
-        // Extract income statement data
-        data.income_statement.revenue = extract_fact_value(facts, "Revenues", filing.accession_number, fy, is_annual);
-        if (data.income_statement.revenue == 0) {
-            data.income_statement.revenue = extract_fact_value(facts, "RevenueFromContractWithCustomerExcludingAssessedTax", filing.accession_number, fy, is_annual);
-        }
-        if (data.income_statement.revenue == 0) {
-            data.income_statement.revenue = extract_fact_value(facts, "SalesRevenueNet", filing.accession_number, fy, is_annual);
-        }
-        
-        data.income_statement.net_income = extract_fact_value(facts, "NetIncomeLoss", filing.accession_number, fy, is_annual);
-        data.income_statement.operating_income = extract_fact_value(facts, "OperatingIncomeLoss", filing.accession_number, fy, is_annual);
-        data.income_statement.gross_profit = extract_fact_value(facts, "GrossProfit", filing.accession_number, fy, is_annual);
-        data.income_statement.cost_of_revenue = extract_fact_value(facts, "CostOfGoodsAndServicesSold", filing.accession_number, fy, is_annual);
-        if (data.income_statement.cost_of_revenue == 0) {
-            data.income_statement.cost_of_revenue = extract_fact_value(facts, "CostOfRevenue", filing.accession_number, fy, is_annual);
-        }
-        
-        // Extract balance sheet data
-        data.balance_sheet.total_assets = extract_fact_value(facts, "Assets", filing.accession_number, fy, is_annual);
-        data.balance_sheet.total_liabilities = extract_fact_value(facts, "Liabilities", filing.accession_number, fy, is_annual);
-        data.balance_sheet.total_equity = extract_fact_value(facts, "StockholdersEquity", filing.accession_number, fy, is_annual);
-        data.balance_sheet.current_assets = extract_fact_value(facts, "AssetsCurrent", filing.accession_number, fy, is_annual);
-        data.balance_sheet.current_liabilities = extract_fact_value(facts, "LiabilitiesCurrent", filing.accession_number, fy, is_annual);
-        data.balance_sheet.cash = extract_fact_value(facts, "CashAndCashEquivalentsAtCarryingValue", filing.accession_number, fy, is_annual);
-        data.balance_sheet.accounts_receivable = extract_fact_value(facts, "AccountsReceivableNetCurrent", filing.accession_number, fy, is_annual);
-        data.balance_sheet.inventory = extract_fact_value(facts, "InventoryNet", filing.accession_number, fy, is_annual);
-        data.balance_sheet.long_term_debt = extract_fact_value(facts, "LongTermDebt", filing.accession_number, fy, is_annual);
-        
-        // Extract cash flow data
-        data.cash_flow.operating_cash_flow = extract_fact_value(facts, "NetCashProvidedByUsedInOperatingActivities", filing.accession_number, fy, is_annual);
-        data.cash_flow.investing_cash_flow = extract_fact_value(facts, "NetCashProvidedByUsedInInvestingActivities", filing.accession_number, fy, is_annual);
-        data.cash_flow.financing_cash_flow = extract_fact_value(facts, "NetCashProvidedByUsedInFinancingActivities", filing.accession_number, fy, is_annual);
-        data.cash_flow.capital_expenditures = extract_fact_value(facts, "PaymentsToAcquirePropertyPlantAndEquipment", filing.accession_number, fy, is_annual);
-        
-        data.is_valid = (data.income_statement.revenue > 0 || data.balance_sheet.total_assets > 0);
-        
-        LOG_INFO("Extracted financial data - Revenue: ${:.0f}M, Net Income: ${:.0f}M", 
-                 data.income_statement.revenue / 1e6, data.income_statement.net_income / 1e6);
-        
-    } catch (const std::exception& e) {
-        LOG_ERROR("Failed to parse company facts: {}", e.what());
-        data.error_message = e.what();
-    }
-    
-    return data;
+    auto facts = get_company_facts(filing.cik, data.error_message);
+    if (!facts) return data;
+    return extract_financial_data(*facts, filing);
 }
 
-std::vector<FinancialData> SECFetcher::get_all_financial_data(const std::string& cik, int years) {
+std::vector<FinancialData> SECFetcher::get_all_financial_data(const std::string& cik, int years,
+                                                              const std::function<void(size_t, size_t)>& on_filing) {
     std::vector<FinancialData> all_data;
     
     LOG_DEBUG("Fetching all financial data for CIK: {}, years: {}", cik, years);
     
     // Get filings for the company
     auto filings = get_filings(cik, years);
-    
-    // Get financial data for each filing
-    for (const auto& filing : filings) {
-        auto data = get_financial_data(filing);
-        if (data) {
-            all_data.push_back(*data);
+    if (filings.empty()) return all_data;
+    
+    // Every filing's numbers come from the same company facts document: fetch and parse it once
+    std::string error;
+    auto facts = get_company_facts(cik, error);
+    
+    all_data.reserve(filings.size());
+    for (size_t i = 0; i < filings.size(); ++i) {
+        if (facts) {
+            all_data.push_back(extract_financial_data(*facts, filings[i]));
+        } else {
+            FinancialData data;
+            data.filing = filings[i];
+            data.is_valid = false;
+            data.error_message = error;
+            all_data.push_back(std::move(data));
+        }
+        if (on_filing) {
+            on_filing(i + 1, filings.size());
         }
     }
     
@@ -362,13 +395,79 @@ std::vector<FinancialData> SECFetcher::get_all_financial_data(const std::string&
     return all_data;
 }
 
-std::optional<std::string> SECFetcher::fetch_url(const std::string& url) {
+std::shared_ptr<const std::string> SECFetcher::fetch_url(const std::string& url, std::string* error) {
+    // A fresh copy skips the rate limiter and the request entirely
+    if (cache_) {
+        auto cached = cache_->get(url);
+        if (cached && cached->fresh) {
+            cache_->record_hit();
+            FetchMetrics::get().cache_hit.inc();
+            return cached->body;
+        }
+    }
+    FetchResult result = fetch_flights_.run(url, [this, &url]() { return fetch_remote(url); });
+    if (!result.body && error) {
+        *error = result.error.empty() ? "Request failed: " + url : result.error;
+    }
+    return std::move(result.body);
+}
+
+SECFetcher::FetchResult SECFetcher::fetch_remote(const std::string& url) {
+    auto& metrics = FetchMetrics::get();
+    
+    // A stale copy is revalidated rather than downloaded again
+    std::optional<CachedResponse> cached = cache_ ? cache_->get(url) : std::nullopt;
+    HttpHeaderList headers;
+    if (cached) {
+        if (!cached->etag.empty()) headers.emplace_back("If-None-Match", cached->etag);
+        if (!cached->last_modified.empty()) headers.emplace_back("If-Modified-Since", cached->last_modified);
+    }
+    
     rate_limit();
-    return http_get(url);
+    std::string error;
+    auto started = std::chrono::steady_clock::now();
+    auto result = http_get(url, headers, error);
+    auto elapsed = std::chrono::steady_clock::now() - started;
+    
+    bool ok = result && (result->status == 200 || (result->status == 304 && cached));
+    if (!ok) {
+        metrics.error_duration.observe(elapsed);
+        if (result) {
+            error = http_status_error(result->status);
+            LOG_ERROR("{}", error);
+        }
+        // Better an old copy than none while SEC is unreachable or failing
+        if (cached && (!result || result->status >= 500)) {
+            LOG_WARNING("Using cached copy of {}: {}", url, error);
+            return {cached->body, {}};
+        }
+        return {nullptr, std::move(error)};
+    }
+    
+    metrics.ok_duration.observe(elapsed);
+    metrics.bytes.inc(result->body.size());
+    if (result->status == 304) {
+        LOG_DEBUG("Not modified: {}", url);
+        cache_->refresh(url, cache_ttl(url));
+        cache_->record_revalidated();
+        metrics.cache_revalidated.inc();
+        return {cached->body, {}};
+    }
+    
+    auto body = std::make_shared<const std::string>(std::move(result->body));
+    if (cache_) {
+        cache_->record_miss();
+        metrics.cache_miss.inc();
+        if (!result->etag.empty() || !result->last_modified.empty() || cache_ttl(url).count() > 0) {
+            cache_->put(url, body, std::move(result->etag), std::move(result->last_modified),
+                        cache_ttl(url));
+        }
+    }
+    return {std::move(body), {}};
 }
 
-std::optional<std::string> SECFetcher::fetch_json(const std::string& endpoint) {
-    return fetch_url(endpoint);
+std::shared_ptr<const std::string> SECFetcher::fetch_json(const std::string& endpoint, std::string* error) {
+    return fetch_url(endpoint, error);
 }
 
 #ifdef _WIN32
@@ -422,7 +521,8 @@ static ParsedUrl parse_url(const std::string& url) {
     return parsed;
 }
 
-std::optional<std::string> SECFetcher::http_get(const std::string& url) {
+std::optional<SECFetcher::HttpResult> SECFetcher::http_get(const std::string& url, const HttpHeaderList& extra_headers,
+                                                           std::string& error) {
     LOG_DEBUG("HTTP GET: {}", url);
     
     auto parsed = parse_url(url);
@@ -440,7 +540,7 @@ std::optional<std::string> SECFetcher::http_get(const std::string& url) {
     );
     
     if (!hSession) {
-        last_error_ = "WinHttpOpen failed: " + std::to_string(GetLastError());
+        error = "WinHttpOpen failed: " + std::to_string(GetLastError());
         return std::nullopt;
     }
     
@@ -453,7 +553,7 @@ std::optional<std::string> SECFetcher::http_get(const std::string& url) {
     );
     
     if (!hConnect) {
-        last_error_ = "WinHttpConnect failed: " + std::to_string(GetLastError());
+        error = "WinHttpConnect failed: " + std::to_string(GetLastError());
         WinHttpCloseHandle(hSession);
         return std::nullopt;
     }
@@ -471,7 +571,7 @@ std::optional<std::string> SECFetcher::http_get(const std::string& url) {
     );
     
     if (!hRequest) {
-        last_error_ = "WinHttpOpenRequest failed: " + std::to_string(GetLastError());
+        error = "WinHttpOpenRequest failed: " + std::to_string(GetLastError());
         WinHttpCloseHandle(hConnect);
         WinHttpCloseHandle(hSession);
         return std::nullopt;
@@ -480,6 +580,10 @@ std::optional<std::string> SECFetcher::http_get(const std::string& url) {
     // Add headers
     std::wstring headers = L"Accept: application/json\r\nUser-Agent: " + 
         std::wstring(user_agent_.begin(), user_agent_.end()) + L"\r\n";
+    for (const auto& [name, value] : extra_headers) {
+        headers += std::wstring(name.begin(), name.end()) + L": " +
+                   std::wstring(value.begin(), value.end()) + L"\r\n";
+    }
     WinHttpAddRequestHeaders(hRequest, headers.c_str(), -1, WINHTTP_ADDREQ_FLAG_ADD);
     
     // Send request
@@ -494,7 +598,7 @@ std::optional<std::string> SECFetcher::http_get(const std::string& url) {
     );
     
     if (!result) {
-        last_error_ = "WinHttpSendRequest failed: " + std::to_string(GetLastError());
+        error = "WinHttpSendRequest failed: " + std::to_string(GetLastError());
         WinHttpCloseHandle(hRequest);
         WinHttpCloseHandle(hConnect);
         WinHttpCloseHandle(hSession);
@@ -504,7 +608,7 @@ std::optional<std::string> SECFetcher::http_get(const std::string& url) {
     // Receive response
     result = WinHttpReceiveResponse(hRequest, nullptr);
     if (!result) {
-        last_error_ = "WinHttpReceiveResponse failed: " + std::to_string(GetLastError());
+        error = "WinHttpReceiveResponse failed: " + std::to_string(GetLastError());
         WinHttpCloseHandle(hRequest);
         WinHttpCloseHandle(hConnect);
         WinHttpCloseHandle(hSession);
@@ -523,85 +627,82 @@ std::optional<std::string> SECFetcher::http_get(const std::string& url) {
         WINHTTP_NO_HEADER_INDEX
     );
     
-    if (statusCode != 200) {
-        std::string error_msg = "HTTP error " + std::to_string(statusCode);
-        if (statusCode == 403) {
-            error_msg += " - SEC requires valid User-Agent with email";
-        } else if (statusCode == 404) {
-            error_msg += " - Resource not found";
-        } else if (statusCode == 429) {
-            error_msg += " - Rate limited, please wait";
+    HttpResult fetched;
+    fetched.status = static_cast<long>(statusCode);
+    
+    // Validators for the response cache; headers are ASCII
+    auto query_header = [hRequest](DWORD info) {
+        wchar_t buffer[256];
+        DWORD size = sizeof(buffer);
+        if (!WinHttpQueryHeaders(hRequest, info, WINHTTP_HEADER_NAME_BY_INDEX, buffer, &size,
+                                 WINHTTP_NO_HEADER_INDEX)) {
+            return std::string();
         }
-        last_error_ = error_msg;
-        LOG_ERROR("{}", error_msg);
-        WinHttpCloseHandle(hRequest);
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
-        return std::nullopt;
-    }
+        std::wstring wide(buffer, size / sizeof(wchar_t));
+        return std::string(wide.begin(), wide.end());
+    };
+    fetched.etag = query_header(WINHTTP_QUERY_ETAG);
+    fetched.last_modified = query_header(WINHTTP_QUERY_LAST_MODIFIED);
     
     // Read response
     std::string response;
     DWORD bytesAvailable = 0;
     
-    do {
-        bytesAvailable = 0;
-        if (!WinHttpQueryDataAvailable(hRequest, &bytesAvailable)) {
-            break;
-        }
+    // Only a 200 carries a body worth reading
+    if (statusCode == 200) {
+        do {
+            bytesAvailable = 0;
+            if (!WinHttpQueryDataAvailable(hRequest, &bytesAvailable)) {
+                break;
+            }
         
-        if (bytesAvailable > 0) {
-            std::vector<char> buffer(bytesAvailable + 1);
-            DWORD bytesRead = 0;
+            if (bytesAvailable > 0) {
+                std::vector<char> buffer(bytesAvailable + 1);
+                DWORD bytesRead = 0;
             
-            if (WinHttpReadData(hRequest, buffer.data(), bytesAvailable, &bytesRead)) {
-                response.append(buffer.data(), bytesRead);
+                if (WinHttpReadData(hRequest, buffer.data(), bytesAvailable, &bytesRead)) {
+                    response.append(buffer.data(), bytesRead);
+                }
             }
-        }
-    } while (bytesAvailable > 0);
+        } while (bytesAvailable > 0);
+    }
     
     // Cleanup
     WinHttpCloseHandle(hRequest);
     WinHttpCloseHandle(hConnect);
     WinHttpCloseHandle(hSession);
     
-    LOG_DEBUG("HTTP response: {} bytes", response.size());
-    return response;
+    LOG_DEBUG("HTTP response: {} ({} bytes)", fetched.status, response.size());
+    fetched.body = std::move(response);
+    return fetched;
 }
 
 #else
-// Linux/macOS implementation using system curl command
-// This avoids requiring OpenSSL or libcurl as linked dependencies
-std::optional<std::string> SECFetcher::http_get(const std::string& url) {
+// Linux/macOS: in-process client over pooled keep-alive connections
+std::optional<SECFetcher::HttpResult> SECFetcher::http_get(const std::string& url, const HttpHeaderList& headers,
+                                                           std::string& error) {
     LOG_DEBUG("HTTP GET: {}", url);
     
-    // Build curl command
-    // -s: silent, -S: show errors, -f: fail on HTTP errors
-    // -L: follow redirects, -A: user agent
-    std::string cmd = "curl -sSfL -A \"" + user_agent_ + "\" \"" + url + "\" 2>&1";
+    HttpHeaderList request{{"User-Agent", user_agent_}};
+    request.insert(request.end(), headers.begin(), headers.end());
     
-    // Execute curl and capture output
-    FILE* pipe = popen(cmd.c_str(), "r");
-    if (!pipe) {
-        last_error_ = "Failed to execute curl command";
+    HttpClientResponse response = http_.get(url, request);
+    if (!response.error.empty()) {
+        error = "HTTP request failed: " + response.error;
+        LOG_ERROR("{}", error);
         return std::nullopt;
     }
     
-    std::string response;
-    char buffer[4096];
-    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-        response += buffer;
-    }
-    
-    int status = pclose(pipe);
-    if (status != 0) {
-        // curl returns non-zero on HTTP errors (due to -f flag)
-        last_error_ = "HTTP request failed: " + response;
-        return std::nullopt;
+    HttpResult result;
+    result.status = response.status;
+    result.etag = response.header("etag");
+    result.last_modified = response.header("last-modified");
+    if (response.status == 200) {
+        result.body = std::move(response.body);
     }
     
-    LOG_DEBUG("HTTP response: {} bytes", response.size());
-    return response;
+    LOG_DEBUG("HTTP response: {} ({} bytes)", result.status, result.body.size());
+    return result;
 }
 #endif
 
@@ -612,7 +713,7 @@ std::string SECFetcher::normalize_cik(const std::string& cik) {
 CompanyInfo SECFetcher::parse_company_info(const std::string& json) {
     CompanyInfo info;
     try {
-        auto data = parse_json(json);
+        auto data = parse_timed(json, "submissions");
         if (data.contains("name")) info.name = data.at("name").as_string();
         if (data.contains("tickers") && data.at("tickers").size() > 0) {
             info.ticker = data.at("tickers")[0].as_string();
@@ -626,7 +727,7 @@ CompanyInfo SECFetcher::parse_company_info(const std::string& json) {
 std::vector<Filing> SECFetcher::parse_filings(const std::string& json, const std::string& cik) {
     std::vector<Filing> filings;
     try {
-        auto data = parse_json(json);
+        auto data = parse_timed(json, "submissions");
         if (data.contains("filings") && data.at("filings").contains("recent")) {
             const auto& recent = data.at("filings").at("recent");
             
@@ -0,0 +1,270 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Static Asset Cache Implementation
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ */
+
+#include <sec_analyzer/static_assets.h>
+#include <sec_analyzer/compression.h>
+#include <sec_analyzer/logger.h>
+#include <sec_analyzer/util.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <cstdint>
+
+#ifdef __linux__
+#define SEC_ANALYZER_HAS_INOTIFY 1
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace sec_analyzer {
+
+namespace {
+
+constexpr auto RESCAN_INTERVAL = std::chrono::seconds(2);
+constexpr auto CHANGE_SETTLE_TIME = std::chrono::milliseconds(100);
+
+bool read_file(const fs::path& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    out = oss.str();
+    return true;
+}
+
+long long mtime_of(const fs::directory_entry& entry) {
+    std::error_code ec;
+    auto time = entry.last_write_time(ec);
+    return ec ? 0 : static_cast<long long>(time.time_since_epoch().count());
+}
+
+} // namespace
+
+StaticAssetCache::StaticAssetCache(std::string root)
+    : root_(std::move(root)), assets_(std::make_shared<const AssetMap>()) {}
+
+StaticAssetCache::~StaticAssetCache() {
+    stop();
+}
+
+void StaticAssetCache::start() {
+    if (running_.exchange(true)) return;
+
+    reload();
+
+#ifdef SEC_ANALYZER_HAS_INOTIFY
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) {
+        LOG_WARNING("inotify unavailable, rescanning {} every {}s", root_, RESCAN_INTERVAL.count());
+    } else {
+        add_watches();
+    }
+#endif
+
+    watcher_ = std::thread(&StaticAssetCache::watch_loop, this);
+}
+
+void StaticAssetCache::stop() {
+    {
+        std::lock_guard<std::mutex> lock(watcher_mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    watcher_cv_.notify_all();
+    if (watcher_.joinable()) {
+        watcher_.join();
+    }
+
+#ifdef SEC_ANALYZER_HAS_INOTIFY
+    if (inotify_fd_ >= 0) {
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+    }
+#endif
+}
+
+std::shared_ptr<const StaticAsset> StaticAssetCache::find(std::string_view url_path) const {
+    std::shared_ptr<const AssetMap> assets;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        assets = assets_;
+    }
+    auto it = assets->find(std::string(url_path));
+    return it != assets->end() ? it->second : nullptr;
+}
+
+size_t StaticAssetCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return assets_->size();
+}
+
+std::string StaticAssetCache::mime_type(const std::string& path) {
+    std::string ext = util::get_extension(path);
+
+    static const std::map<std::string, std::string> mime_types = {
+        {"html", "text/html; charset=utf-8"},
+        {"htm", "text/html; charset=utf-8"},
+        {"css", "text/css; charset=utf-8"},
+        {"js", "application/javascript; charset=utf-8"},
+        {"json", "application/json; charset=utf-8"},
+        {"png", "image/png"},
+        {"jpg", "image/jpeg"},
+        {"jpeg", "image/jpeg"},
+        {"gif", "image/gif"},
+        {"svg", "image/svg+xml"},
+        {"ico", "image/x-icon"},
+        {"txt", "text/plain; charset=utf-8"},
+        {"xml", "application/xml"},
+        {"pdf", "application/pdf"},
+        {"csv", "text/csv"},
+        {"woff", "font/woff"},
+        {"woff2", "font/woff2"},
+        {"ttf", "font/ttf"},
+    };
+
+    auto it = mime_types.find(ext);
+    return (it != mime_types.end()) ? it->second : "application/octet-stream";
+}
+
+std::string StaticAssetCache::file_etag(size_t size, long long mtime) {
+    return util::quoted_etag(util::to_hex(static_cast<uint64_t>(mtime)), util::to_hex(size));
+}
+
+std::shared_ptr<const StaticAssetCache::AssetMap> StaticAssetCache::build() const {
+    auto assets = std::make_shared<AssetMap>();
+    size_t cached_bytes = 0;
+
+    std::error_code ec;
+    fs::recursive_directory_iterator it(root_, fs::directory_options::skip_permission_denied, ec);
+    if (ec) {
+        LOG_WARNING("Static directory {} not readable: {}", root_, ec.message());
+        return assets;
+    }
+
+    for (const auto& entry : it) {
+        if (!entry.is_regular_file(ec)) continue;
+
+        auto asset = std::make_shared<StaticAsset>();
+        asset->file_path = entry.path().string();
+        asset->content_type = mime_type(asset->file_path);
+        asset->size = static_cast<size_t>(entry.file_size(ec));
+        if (ec) continue;
+
+        if (asset->size <= MAX_CACHED_FILE_SIZE) {
+            auto body = std::make_shared<std::string>();
+            if (!read_file(entry.path(), *body)) continue;
+            asset->size = body->size();
+            asset->etag = util::quoted_etag(util::to_hex(util::fnv1a64(*body)));
+
+            if (body->size() >= MIN_COMPRESS_SIZE && compression::is_compressible(asset->content_type)) {
+                auto gz = std::make_shared<std::string>();
+                if (compression::gzip(*body, *gz, 9) && gz->size() < body->size()) {
+                    cached_bytes += gz->size();
+                    asset->gzip_body = std::move(gz);
+                }
+            }
+            cached_bytes += body->size();
+            asset->body = std::move(body);
+        } else {
+            asset->etag = file_etag(asset->size, mtime_of(entry));
+        }
+
+        std::string relative = fs::relative(entry.path(), root_, ec).generic_string();
+        if (ec) continue;
+        std::string url;
+        url.reserve(relative.size() + 1);
+        url.append(1, '/').append(relative);
+        (*assets)[url] = std::move(asset);
+    }
+
+    LOG_DEBUG("Static cache: {} assets, {} bytes resident", assets->size(), cached_bytes);
+    return assets;
+}
+
+void StaticAssetCache::reload() {
+    auto next = build();
+    std::lock_guard<std::mutex> lock(mutex_);
+    assets_ = std::move(next);
+}
+
+void StaticAssetCache::add_watches() {
+#ifdef SEC_ANALYZER_HAS_INOTIFY
+    // Re-adding an existing watch is a no-op, so this also picks up new subdirectories
+    constexpr uint32_t mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                              IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+    inotify_add_watch(inotify_fd_, root_.c_str(), mask);
+
+    std::error_code ec;
+    fs::recursive_directory_iterator it(root_, fs::directory_options::skip_permission_denied, ec);
+    if (ec) return;
+    for (const auto& entry : it) {
+        if (entry.is_directory(ec)) {
+            inotify_add_watch(inotify_fd_, entry.path().c_str(), mask);
+        }
+    }
+#endif
+}
+
+std::string StaticAssetCache::scan_signature() const {
+    std::ostringstream oss;
+    std::error_code ec;
+    fs::recursive_directory_iterator it(root_, fs::directory_options::skip_permission_denied, ec);
+    if (ec) return "";
+    for (const auto& entry : it) {
+        if (!entry.is_regular_file(ec)) continue;
+        oss << entry.path().string() << '|' << entry.file_size(ec) << '|' << mtime_of(entry) << '\n';
+    }
+    return oss.str();
+}
+
+void StaticAssetCache::watch_loop() {
+#ifdef SEC_ANALYZER_HAS_INOTIFY
+    if (inotify_fd_ >= 0) {
+        char events[4096];
+        while (running_) {
+            pollfd pfd{inotify_fd_, POLLIN, 0};
+            if (poll(&pfd, 1, 500) <= 0) continue;
+            while (read(inotify_fd_, events, sizeof(events)) > 0) {}
+
+            // Let a burst of writes (editor saves, deploys) settle into one reload
+            {
+                std::unique_lock<std::mutex> lock(watcher_mutex_);
+                watcher_cv_.wait_for(lock, CHANGE_SETTLE_TIME, [this]() { return !running_; });
+            }
+            if (!running_) break;
+            while (read(inotify_fd_, events, sizeof(events)) > 0) {}
+
+            reload();
+            add_watches();
+            LOG_INFO("Static assets reloaded from {} ({} files)", root_, size());
+        }
+        return;
+    }
+#endif
+
+    std::string signature = scan_signature();
+    while (running_) {
+        {
+            std::unique_lock<std::mutex> lock(watcher_mutex_);
+            watcher_cv_.wait_for(lock, RESCAN_INTERVAL, [this]() { return !running_; });
+        }
+        if (!running_) break;
+
+        std::string next = scan_signature();
+        if (next != signature) {
+            signature = std::move(next);
+            reload();
+            LOG_INFO("Static assets reloaded from {} ({} files)", root_, size());
+        }
+    }
+}
+
+} // namespace sec_analyzer
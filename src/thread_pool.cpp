@@ -0,0 +1,204 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Worker Thread Pool Implementation
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ */
+
+#include <sec_analyzer/thread_pool.h>
+#include <sec_analyzer/logger.h>
+
+#include <algorithm>
+
+namespace sec_analyzer {
+
+namespace {
+
+// Identifies the pool/worker the current thread belongs to, if any
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local size_t tls_worker_index = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t thread_count, size_t queue_capacity)
+    : thread_count_(thread_count), queue_capacity_(queue_capacity) {
+    if (thread_count_ == 0) {
+        thread_count_ = std::max(2u, std::thread::hardware_concurrency());
+    }
+    if (queue_capacity_ == 0) {
+        queue_capacity_ = 1;
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    shutdown();
+}
+
+void ThreadPool::start() {
+    if (running_.exchange(true)) return;
+
+    workers_.clear();
+    for (size_t i = 0; i < thread_count_; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+
+    threads_.reserve(thread_count_);
+    for (size_t i = 0; i < thread_count_; ++i) {
+        threads_.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+    LOG_DEBUG("Thread pool started with {} workers, queue capacity {}", thread_count_, queue_capacity_);
+}
+
+void ThreadPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    cv_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    global_.clear();
+    workers_.clear();
+    pending_ = 0;
+}
+
+bool ThreadPool::submit(Task task) {
+    if (!running_) return false;
+
+    // Reserve a queue slot; the bound covers global and per-worker queues
+    size_t depth = pending_.load();
+    do {
+        if (depth >= queue_capacity_) {
+            ++rejected_;
+            return false;
+        }
+    } while (!pending_.compare_exchange_weak(depth, depth + 1));
+
+    Item item{std::move(task), std::chrono::steady_clock::now()};
+
+    if (tls_pool == this) {
+        // Nested submission: keep it local, peers can steal it
+        Worker& self = *workers_[tls_worker_index];
+        std::lock_guard<std::mutex> lock(self.mutex);
+        self.deque.push_back(std::move(item));
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            --pending_;
+            return false;
+        }
+        global_.push_back(std::move(item));
+    }
+    ++submitted_;
+
+    // Taking the lock orders this wake-up after any waiter's predicate check
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    cv_.notify_one();
+    return true;
+}
+
+ThreadPoolStats ThreadPool::stats() const {
+    ThreadPoolStats s;
+    s.thread_count = thread_count_;
+    s.queue_depth = pending_;
+    s.queue_capacity = queue_capacity_;
+    s.active = active_;
+    s.submitted = submitted_;
+    s.completed = completed_;
+    s.rejected = rejected_;
+    s.steals = steals_;
+    uint64_t started = completed_ + active_;
+    s.avg_wait_ms = started > 0 ? static_cast<double>(total_wait_us_) / started / 1000.0 : 0;
+    s.max_wait_ms = static_cast<double>(max_wait_us_) / 1000.0;
+    return s;
+}
+
+bool ThreadPool::try_pop(size_t index, Item& item) {
+    // 1. Own deque, newest first (cache-warm nested work)
+    {
+        Worker& self = *workers_[index];
+        std::lock_guard<std::mutex> lock(self.mutex);
+        if (!self.deque.empty()) {
+            item = std::move(self.deque.back());
+            self.deque.pop_back();
+            return true;
+        }
+    }
+
+    // 2. Global submission queue, oldest first
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!global_.empty()) {
+            item = std::move(global_.front());
+            global_.pop_front();
+            return true;
+        }
+    }
+
+    // 3. Steal the oldest task from a peer
+    for (size_t offset = 1; offset < workers_.size(); ++offset) {
+        Worker& victim = *workers_[(index + offset) % workers_.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (lock.owns_lock() && !victim.deque.empty()) {
+            item = std::move(victim.deque.front());
+            victim.deque.pop_front();
+            ++steals_;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::run_item(Item& item) {
+    --pending_;
+    ++active_;
+
+    auto wait = std::chrono::steady_clock::now() - item.enqueued;
+    uint64_t wait_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(wait).count());
+    total_wait_us_ += wait_us;
+    uint64_t prev_max = max_wait_us_;
+    while (wait_us > prev_max && !max_wait_us_.compare_exchange_weak(prev_max, wait_us)) {}
+
+    try {
+        item.task();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Worker task failed: {}", e.what());
+    } catch (...) {
+        LOG_ERROR("Worker task failed with unknown error");
+    }
+
+    --active_;
+    ++completed_;
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    tls_pool = this;
+    tls_worker_index = index;
+
+    while (running_) {
+        Item item;
+        if (try_pop(index, item)) {
+            run_item(item);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        // Timed wait covers a task parked on a peer deque whose owner is busy
+        cv_.wait_for(lock, std::chrono::milliseconds(50), [this]() {
+            return !running_ || pending_ > 0;
+        });
+    }
+
+    tls_pool = nullptr;
+}
+
+} // namespace sec_analyzer
@@ -0,0 +1,75 @@
+/**
+ * SEC EDGAR Fraud Analyzer - Timer Wheel Implementation
+ * Version: 2.1.2
+ * Author: Bennie Shearer (Retired)
+ */
+
+#include <sec_analyzer/timer_wheel.h>
+
+#include <algorithm>
+
+namespace sec_analyzer {
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick, size_t slot_count)
+    : tick_(std::max(tick, std::chrono::milliseconds(1))), epoch_(Clock::now()) {
+    // Round up to a power of two so the slot is a mask, not a division
+    size_t size = 1;
+    while (size < slot_count) size <<= 1;
+    slots_.resize(size);
+    mask_ = size - 1;
+    for (Timer& head : slots_) {
+        head.prev = head.next = &head;
+    }
+}
+
+uint64_t TimerWheel::tick_of(Clock::time_point time) const {
+    if (time <= epoch_) return 0;
+    return static_cast<uint64_t>((time - epoch_) / tick_);
+}
+
+void TimerWheel::schedule(Timer& timer, std::chrono::milliseconds delay) {
+    cancel(timer);
+
+    int64_t delay_ms = std::max<int64_t>(0, delay.count());
+    uint64_t ticks = static_cast<uint64_t>((delay_ms + tick_.count() - 1) / tick_.count());
+    timer.expires = std::max(tick_of(Clock::now()), current_) + std::max<uint64_t>(ticks, 1);
+
+    Timer& head = slots_[timer.expires & mask_];
+    timer.prev = head.prev;
+    timer.next = &head;
+    head.prev->next = &timer;
+    head.prev = &timer;
+    ++armed_;
+}
+
+void TimerWheel::cancel(Timer& timer) {
+    if (!timer.armed()) return;
+    timer.prev->next = timer.next;
+    timer.next->prev = timer.prev;
+    timer.prev = timer.next = nullptr;
+    --armed_;
+}
+
+void TimerWheel::advance(Clock::time_point now, std::vector<Timer*>& expired) {
+    uint64_t target = tick_of(now);
+    if (target <= current_) return;
+
+    // After a long stall every slot is visited once; the expiry check below
+    // still only takes timers that are actually due
+    uint64_t first = target - current_ > slots_.size() ? target - slots_.size() + 1 : current_ + 1;
+    for (uint64_t tick = first; tick <= target && armed_ > 0; ++tick) {
+        Timer& head = slots_[tick & mask_];
+        Timer* timer = head.next;
+        while (timer != &head) {
+            Timer* next = timer->next;
+            if (timer->expires <= target) {
+                cancel(*timer);
+                expired.push_back(timer);
+            }
+            timer = next;
+        }
+    }
+    current_ = target;
+}
+
+} // namespace sec_analyzer